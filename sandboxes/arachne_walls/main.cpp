@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include "libslic3r/ClipperUtils.hpp"
+#include "libslic3r/PrintConfig.hpp"
+#include "libslic3r/Arachne/WallToolPaths.hpp"
+
+#include "libnest2d/tools/benchmark.h"
+
+// Benchmark of the Arachne perimeter generator on synthetic thin walled shapes.
+// Usage: arachne_walls [number of copies of the shapes] [perimeters]
+
+namespace Slic3r {
+
+// Wedges of a slowly growing thickness (lots of bead count transitions), a star and a ring of a varying thickness.
+static Polygons make_thin_walled_shapes(size_t copies)
+{
+    Polygons out;
+    for (size_t copy = 0; copy < copies; ++ copy) {
+        const double x0 = 200. * double(copy % 10);
+        const double y0 = 50. * double(copy / 10);
+        for (int i = 0; i < 6; ++ i) {
+            const double y = y0 + i * 6.;
+            out.emplace_back(Points{ Point::new_scale(x0, y), Point::new_scale(x0 + 60., y + 0.2 + i * 0.3),
+                                     Point::new_scale(x0 + 60., y + 3. + i * 0.3), Point::new_scale(x0, y + 0.1) });
+        }
+        Polygon star;
+        for (int k = 0; k < 80; ++ k) {
+            const double a = 2. * PI * k / 80.;
+            const double r = (k % 2) ? 10. : 4. + 0.5 * std::sin(k);
+            star.points.emplace_back(Point::new_scale(x0 + 100. + r * std::cos(a), y0 + 20. + r * std::sin(a)));
+        }
+        out.emplace_back(std::move(star));
+        Polygon outer, inner;
+        for (int k = 0; k < 400; ++ k) {
+            const double a = 2. * PI * k / 400.;
+            const double t = 0.3 + 1.5 * (1. + std::sin(3. * a));
+            outer.points.emplace_back(Point::new_scale(x0 + 150. + 15. * std::cos(a), y0 + 20. + 15. * std::sin(a)));
+            inner.points.emplace_back(Point::new_scale(x0 + 150. + (15. - t) * std::cos(a), y0 + 20. + (15. - t) * std::sin(a)));
+        }
+        inner.reverse();
+        out.emplace_back(std::move(outer));
+        out.emplace_back(std::move(inner));
+    }
+    return union_(out);
+}
+
+} // namespace Slic3r
+
+int main(const int argc, const char *argv[])
+{
+    using namespace Slic3r;
+
+    const size_t copies     = argc > 1 ? std::stoul(argv[1]) : 20;
+    const size_t perimeters = argc > 2 ? std::stoul(argv[2]) : 3;
+
+    const Polygons          outline = make_thin_walled_shapes(copies);
+    const PrintObjectConfig object_config;
+    const PrintConfig       print_config;
+    const coord_t           width   = scaled<coord_t>(0.45);
+    const coord_t           spacing = scaled<coord_t>(0.4);
+
+    size_t num_lines = 0;
+    size_t num_junctions = 0;
+    Benchmark b;
+    b.start();
+    Arachne::WallToolPaths wall_tool_paths(outline, spacing, width, spacing, width, perimeters, 0, 0.2, object_config, print_config);
+    for (const Arachne::VariableWidthLines &lines : wall_tool_paths.generate())
+        for (const Arachne::ExtrusionLine &line : lines) {
+            ++ num_lines;
+            num_junctions += line.junctions.size();
+        }
+    b.stop();
+
+    std::cout << outline.size() << " polygons, " << perimeters << " perimeters: " << b.getElapsedSec() << " s, "
+              << num_lines << " extrusion lines, " << num_junctions << " junctions" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <boost/filesystem.hpp>
+
+#include "libslic3r/Model.hpp"
+#include "libslic3r/TriangleMesh.hpp"
+#include "libslic3r/Format/3mf.hpp"
+
+#include "libnest2d/tools/benchmark.h"
+
+// Measures the time to save a synthetic project into a 3mf file with various compression levels.
+// Usage: export_3mf [output_dir] [millions of triangles] [number of objects]
+
+namespace Slic3r {
+
+static Model make_project(size_t num_triangles, size_t num_objects)
+{
+    // A sphere tessellated with the angle step fa has roughly 4 * PI^2 / fa^2 triangles.
+    const double fa     = std::sqrt(4. * PI * PI * double(num_objects) / double(num_triangles));
+    TriangleMesh sphere = make_sphere(10., fa);
+
+    Model model;
+    for (size_t i = 0; i < num_objects; ++ i) {
+        ModelObject *object = model.add_object();
+        object->name = "sphere_" + std::to_string(i);
+        object->add_volume(sphere);
+        object->add_instance()->set_offset(Vec3d(25. * double(i), 0., 10.));
+    }
+    return model;
+}
+
+} // namespace Slic3r
+
+int main(const int argc, const char *argv[])
+{
+    using namespace Slic3r;
+
+    const boost::filesystem::path out_dir     = argc > 1 ? argv[1] : boost::filesystem::temp_directory_path().string();
+    const size_t                  num_tris    = size_t((argc > 2 ? std::stod(argv[2]) : 10.) * 1e6);
+    const size_t                  num_objects = argc > 3 ? std::stoul(argv[3]) : 8;
+
+    Model model = make_project(num_tris, num_objects);
+    size_t facets = 0;
+    for (const ModelObject *object : model.objects)
+        facets += object->facets_count();
+    std::cout << "Project with " << model.objects.size() << " objects, " << facets << " triangles" << std::endl;
+
+    const std::string path = (out_dir / "export_3mf_benchmark.3mf").string();
+    for (int level : { 0, 1, 6, 9 }) {
+        Benchmark b;
+        b.start();
+        bool ok = store_3mf(path.c_str(), &model, nullptr, OptionStore3mf{}.set_compression_level(level));
+        b.stop();
+        std::cout << "Compression level " << level << ": " << (ok ? "" : "FAILED ") << b.getElapsedSec() << " s, "
+                  << (ok ? boost::filesystem::file_size(path) / (1024 * 1024) : 0) << " MiB" << std::endl;
+    }
+    boost::filesystem::remove(path);
+
+    return 0;
+}
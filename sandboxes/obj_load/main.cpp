@@ -0,0 +1,87 @@
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <boost/filesystem.hpp>
+
+#include "libslic3r/TriangleMesh.hpp"
+#include "libslic3r/Format/OBJ.hpp"
+#include "libslic3r/Format/objparser.hpp"
+
+#include "libnest2d/tools/benchmark.h"
+
+// Compares the line by line ObjData parser with the memory mapped parallel mesh parser on a synthetic OBJ file.
+// Usage: obj_load [output_dir] [millions of triangles]
+
+namespace Slic3r {
+
+// The former OBJ loading path: parse into ObjData, then convert to an indexed triangle set.
+static bool load_obj_data(const char *path, indexed_triangle_set &its)
+{
+    ObjParser::ObjData data;
+    if (! ObjParser::objparse(path, data))
+        return false;
+    its.vertices.reserve(data.coordinates.size() / 4);
+    for (size_t i = 0; i < data.coordinates.size(); i += 4)
+        its.vertices.emplace_back(data.coordinates[i], data.coordinates[i + 1], data.coordinates[i + 2]);
+    int indices[4];
+    int cnt = 0;
+    for (const ObjParser::ObjVertex &vertex : data.vertices)
+        if (vertex.coordIdx != -1) {
+            if (cnt == 4)
+                return false;
+            indices[cnt ++] = vertex.coordIdx;
+        } else if (cnt > 0) {
+            its.indices.emplace_back(indices[0], indices[1], indices[2]);
+            if (cnt == 4)
+                its.indices.emplace_back(indices[0], indices[2], indices[3]);
+            cnt = 0;
+        }
+    return true;
+}
+
+} // namespace Slic3r
+
+int main(const int argc, const char *argv[])
+{
+    using namespace Slic3r;
+
+    const boost::filesystem::path out_dir  = argc > 1 ? argv[1] : boost::filesystem::temp_directory_path().string();
+    const size_t                  num_tris = size_t((argc > 2 ? std::stod(argv[2]) : 5.) * 1e6);
+
+    // A sphere tessellated with the angle step fa has roughly 4 * PI^2 / fa^2 triangles.
+    TriangleMesh      sphere = make_sphere(10., std::sqrt(4. * PI * PI / double(num_tris)));
+    const std::string path   = (out_dir / "obj_load_benchmark.obj").string();
+    store_obj(path.c_str(), &sphere);
+    std::cout << "OBJ file with " << sphere.facets_count() << " triangles, "
+              << boost::filesystem::file_size(path) / (1024 * 1024) << " MiB" << std::endl;
+
+    {
+        indexed_triangle_set its;
+        Benchmark b;
+        b.start();
+        bool ok = load_obj_data(path.c_str(), its);
+        b.stop();
+        std::cout << "ObjData parser: " << (ok ? "" : "FAILED ") << b.getElapsedSec() << " s, " << its.indices.size() << " triangles" << std::endl;
+    }
+    {
+        indexed_triangle_set its;
+        std::string error;
+        Benchmark b;
+        b.start();
+        bool ok = ObjParser::objparse_mesh(path.c_str(), its, error);
+        b.stop();
+        std::cout << "Mesh parser: " << (ok ? "" : "FAILED ") << b.getElapsedSec() << " s, " << its.indices.size() << " triangles" << std::endl;
+    }
+    {
+        TriangleMesh mesh;
+        Benchmark b;
+        b.start();
+        bool ok = load_obj(path.c_str(), &mesh);
+        b.stop();
+        std::cout << "load_obj including mesh statistics: " << (ok ? "" : "FAILED ") << b.getElapsedSec() << " s" << std::endl;
+    }
+    boost::filesystem::remove(path);
+
+    return 0;
+}
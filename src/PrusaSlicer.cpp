@@ -42,6 +42,8 @@
 #include "libslic3r/Format/Format.hpp"
 #include "libslic3r/Format/STL.hpp"
 #include "libslic3r/Format/OBJ.hpp"
+#include "libslic3r/Format/MeshCache.hpp"
+#include "libslic3r/Format/STEP.hpp"
 #include "libslic3r/Format/SL1.hpp"
 #include "libslic3r/Format/CWS.hpp"
 #include "libslic3r/Utils.hpp"
@@ -718,6 +720,8 @@ bool CLI::setup(int argc, char **argv)
             m_config.option(optdef.first, true);
 
     set_data_dir(m_config.opt_string("datadir"));
+    set_mesh_cache_dir(m_config.opt_string("mesh_cache"));
+    set_step_deflection(m_config.opt_float("step_linear_deflection"), m_config.opt_float("step_angular_deflection"));
     
     //FIXME Validating at this stage most likely does not make sense, as the config is not fully initialized yet.
     if (!validity.empty()) {
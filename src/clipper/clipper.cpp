@@ -790,8 +790,8 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
   if ((Closed && highI < 2) || (!Closed && highI < 1))
     return false;
 
-  // Allocate a new edge array.
-  std::vector<TEdge> edges(highI + 1);
+  // Allocate a new edge array, reuse the memory of an edge array released by Clear() if possible.
+  std::vector<TEdge> edges = AllocateEdges(highI + 1);
   // Fill in the edge array.
   bool result = AddPathInternal(pg, highI, PolyTyp, Closed, edges.data());
   if (result)
@@ -978,10 +978,24 @@ bool ClipperBase::AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, b
 }
 //------------------------------------------------------------------------------
 
+std::vector<TEdge> ClipperBase::AllocateEdges(size_t num_edges)
+{
+  std::vector<TEdge> edges;
+  if (! m_edgesFree.empty()) {
+    edges = std::move(m_edgesFree.back());
+    m_edgesFree.pop_back();
+  }
+  edges.assign(num_edges, TEdge());
+  return edges;
+}
+//------------------------------------------------------------------------------
+
 void ClipperBase::Clear()
 {
   CLIPPERLIB_PROFILE_FUNC();
   m_MinimaList.clear();
+  for (std::vector<TEdge> &edges : m_edges)
+    m_edgesFree.emplace_back(std::move(edges));
   m_edges.clear();
 #ifndef CLIPPERLIB_INT32
   m_UseFullRange = false;
@@ -990,6 +1004,24 @@ void ClipperBase::Clear()
 }
 //------------------------------------------------------------------------------
 
+size_t ClipperBase::RetainedMemory() const
+{
+  size_t out = m_MinimaList.capacity() * sizeof(LocalMinimum) + (m_edges.capacity() + m_edgesFree.capacity()) * sizeof(std::vector<TEdge>);
+  for (const std::vector<TEdge> &edges : m_edgesFree)
+    out += edges.capacity() * sizeof(TEdge);
+  return out;
+}
+//------------------------------------------------------------------------------
+
+void ClipperBase::ReleaseRetainedMemory()
+{
+  assert(m_edges.empty());
+  std::vector<LocalMinimum>().swap(m_MinimaList);
+  std::vector<std::vector<TEdge>>().swap(m_edges);
+  std::vector<std::vector<TEdge>>().swap(m_edgesFree);
+}
+//------------------------------------------------------------------------------
+
 // Initialize the Local Minima List:
 // Sort the LML entries, initialize the left / right bound edges of each Local Minima.
 void ClipperBase::Reset()
@@ -1068,6 +1100,7 @@ Clipper::Clipper(int initOptions) :
   ClipperBase(),
   m_OutPtsFree(nullptr),
   m_OutPtsChunkSize(32),
+  m_OutPtsChunk(size_t(-1)),
   m_OutPtsChunkLast(32),
   m_ActiveEdges(nullptr),
   m_SortedEdges(nullptr)
@@ -1082,16 +1115,26 @@ Clipper::Clipper(int initOptions) :
 }
 //------------------------------------------------------------------------------
 
+Clipper::~Clipper()
+{
+  Clear();
+  for (OutPt *pts : m_OutPts)
+    delete[] pts;
+  for (OutRec *rec : m_PolyOutsFree)
+    delete rec;
+}
+//------------------------------------------------------------------------------
+
 void Clipper::Reset()
 {
   CLIPPERLIB_PROFILE_FUNC();
   ClipperBase::Reset();
-  m_Scanbeam = std::priority_queue<cInt>();
+  m_Scanbeam.clear();
   m_Maxima.clear();
   m_ActiveEdges = 0;
   m_SortedEdges = 0;
   for (auto lm = m_MinimaList.rbegin(); lm != m_MinimaList.rend(); ++lm)
-    m_Scanbeam.push(lm->Y);
+    ScanbeamPush(lm->Y);
 }
 
 //------------------------------------------------------------------------------
@@ -1137,15 +1180,17 @@ bool Clipper::ExecuteInternal()
    CLIPPERLIB_PROFILE_BLOCK(Clipper_ExecuteInternal_Process);
     Reset();
     if (m_MinimaList.empty()) return true;
-    cInt botY = m_Scanbeam.top();
-    do { m_Scanbeam.pop(); } while (! m_Scanbeam.empty() && botY == m_Scanbeam.top());
+    cInt botY = ScanbeamPop();
+    while (! m_Scanbeam.empty() && botY == m_Scanbeam.front())
+      ScanbeamPop();
     do {
       InsertLocalMinimaIntoAEL(botY);
       ProcessHorizontals();
 	    m_GhostJoins.clear();
 	    if (m_Scanbeam.empty()) break;
-      cInt topY = m_Scanbeam.top();
-      do { m_Scanbeam.pop(); } while (! m_Scanbeam.empty() && topY == m_Scanbeam.top());
+      cInt topY = ScanbeamPop();
+      while (! m_Scanbeam.empty() && topY == m_Scanbeam.front())
+        ScanbeamPop();
       succeeded = ProcessIntersections(topY);
       if (!succeeded) break;
       ProcessEdgesAtTopOfScanbeam(topY);
@@ -1207,27 +1252,57 @@ OutPt* Clipper::AllocateOutPt()
     pt = m_OutPtsFree;
     m_OutPtsFree = pt->Next;
   } else if (m_OutPtsChunkLast < m_OutPtsChunkSize) {
-    // Get a point from the last chunk.
-    pt = m_OutPts.back() + (m_OutPtsChunkLast ++);
+    // Get a point from the current chunk.
+    pt = m_OutPts[m_OutPtsChunk] + (m_OutPtsChunkLast ++);
   } else {
-    // The last chunk is full. Allocate a new one.
-    m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
+    // The current chunk is full. Continue with a chunk retained from the previous operations, or allocate a new one.
+    if (++ m_OutPtsChunk == m_OutPts.size())
+      m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
     m_OutPtsChunkLast = 1;
-    pt = m_OutPts.back();
+    pt = m_OutPts[m_OutPtsChunk];
   }
   return pt;
 }
 
+// Release the output records and points for reuse by the next operation, the memory is freed by ~Clipper()
+// or by ReleaseRetainedMemory().
 void Clipper::DisposeAllOutRecs()
 {
+  m_PolyOutsFree.insert(m_PolyOutsFree.end(), m_PolyOuts.begin(), m_PolyOuts.end());
+  m_PolyOuts.clear();
+  m_OutPtsFree = nullptr;
+  m_OutPtsChunk = size_t(-1);
+  m_OutPtsChunkLast = m_OutPtsChunkSize;
+}
+//------------------------------------------------------------------------------
+
+size_t Clipper::RetainedMemory() const
+{
+  return ClipperBase::RetainedMemory() +
+    m_OutPts.size() * m_OutPtsChunkSize * sizeof(OutPt) + m_OutPts.capacity() * sizeof(OutPt*) +
+    m_PolyOutsFree.size() * sizeof(OutRec) + (m_PolyOuts.capacity() + m_PolyOutsFree.capacity()) * sizeof(OutRec*) +
+    (m_Joins.capacity() + m_GhostJoins.capacity()) * sizeof(Join) + m_IntersectList.capacity() * sizeof(IntersectNode) +
+    (m_Scanbeam.capacity() + m_Maxima.capacity()) * sizeof(cInt);
+}
+//------------------------------------------------------------------------------
+
+void Clipper::ReleaseRetainedMemory()
+{
+  assert(m_PolyOuts.empty());
+  ClipperBase::ReleaseRetainedMemory();
   for (OutPt *pts : m_OutPts)
     delete[] pts;
-  for (OutRec *rec : m_PolyOuts)
+  std::vector<OutPt*>().swap(m_OutPts);
+  for (OutRec *rec : m_PolyOutsFree)
     delete rec;
-  m_OutPts.clear();
-  m_OutPtsFree = nullptr;
-  m_OutPtsChunkLast = m_OutPtsChunkSize;
-  m_PolyOuts.clear();
+  std::vector<OutRec*>().swap(m_PolyOutsFree);
+  std::vector<OutRec*>().swap(m_PolyOuts);
+  std::vector<Join>().swap(m_Joins);
+  std::vector<Join>().swap(m_GhostJoins);
+  std::vector<IntersectNode>().swap(m_IntersectList);
+  std::vector<cInt>().swap(m_Scanbeam);
+  std::vector<cInt>().swap(m_Maxima);
+  DisposeAllOutRecs();
 }
 //------------------------------------------------------------------------------
 
@@ -1546,7 +1621,7 @@ void Clipper::InsertLocalMinimaIntoAEL(const cInt botY)
       SetWindingCount(*lb);
       if (IsContributing(*lb))
         Op1 = AddOutPt(lb, lb->Bot);
-      m_Scanbeam.push(lb->Top.y());
+      ScanbeamPush(lb->Top.y());
     }
     else
     {
@@ -1557,13 +1632,13 @@ void Clipper::InsertLocalMinimaIntoAEL(const cInt botY)
       rb->WindCnt2 = lb->WindCnt2;
       if (IsContributing(*lb))
         Op1 = AddLocalMinPoly(lb, rb, lb->Bot);      
-      m_Scanbeam.push(lb->Top.y());
+      ScanbeamPush(lb->Top.y());
     }
 
      if (rb)
      {
        if(IsHorizontal(*rb)) AddEdgeToSEL(rb);
-       else m_Scanbeam.push(rb->Top.y());
+       else ScanbeamPush(rb->Top.y());
      }
 
     if (!lb || !rb) continue;
@@ -2010,7 +2085,13 @@ void Clipper::AppendPolygon(TEdge *e1, TEdge *e2) const
 
 OutRec* Clipper::CreateOutRec()
 {
-  OutRec* result = new OutRec;
+  OutRec* result;
+  if (m_PolyOutsFree.empty())
+    result = new OutRec;
+  else {
+    result = m_PolyOutsFree.back();
+    m_PolyOutsFree.pop_back();
+  }
   result->IsHole = false;
   result->IsOpen = false;
   result->FirstLeft = 0;
@@ -2445,7 +2526,7 @@ void Clipper::UpdateEdgeIntoAEL(TEdge *&e)
   e->PrevInAEL = AelPrev;
   e->NextInAEL = AelNext;
   if (!IsHorizontal(*e)) 
-    m_Scanbeam.push(e->Top.y());
+    ScanbeamPush(e->Top.y());
 }
 //------------------------------------------------------------------------------
 
@@ -3384,6 +3465,28 @@ void ClipperOffset::Clear()
 }
 //------------------------------------------------------------------------------
 
+size_t ClipperOffset::RetainedMemory() const
+{
+  size_t out = m_clipper.RetainedMemory() + m_destPolys.capacity() * sizeof(Path) +
+    (m_srcPoly.capacity() + m_destPoly.capacity()) * sizeof(IntPoint) + m_normals.capacity() * sizeof(DoublePoint);
+  for (const Path &path : m_destPolys)
+    out += path.capacity() * sizeof(IntPoint);
+  return out;
+}
+//------------------------------------------------------------------------------
+
+void ClipperOffset::ReleaseRetainedMemory()
+{
+  assert(m_polyNodes.Childs.empty());
+  m_clipper.ReleaseRetainedMemory();
+  Paths().swap(m_destPolys);
+  Path().swap(m_srcPoly);
+  Path().swap(m_destPoly);
+  std::vector<DoublePoint>().swap(m_normals);
+  std::vector<PolyNode*>().swap(m_polyNodes.Childs);
+}
+//------------------------------------------------------------------------------
+
 void ClipperOffset::AddPath(const Path& path, JoinType joinType, EndType endType)
 {
   int highI = (int)path.size() - 1;
@@ -3481,7 +3584,9 @@ void ClipperOffset::Execute(Paths& solution, double delta)
   DoOffset(delta);
   
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3502,6 +3607,7 @@ void ClipperOffset::Execute(Paths& solution, double delta)
     if (! solution.empty())
       solution.erase(solution.begin());
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -3512,7 +3618,9 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
   DoOffset(delta);
 
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.Clear();
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3533,6 +3641,7 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
     //remove the outer PolyNode rectangle ...
     solution.RemoveOutermostPolygon();
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -58,6 +58,7 @@
 #include <ostream>
 #include <functional>
 #include <queue>
+#include <algorithm>
 
 #ifdef CLIPPERLIB_NAMESPACE_PREFIX
   namespace CLIPPERLIB_NAMESPACE_PREFIX {
@@ -330,8 +331,8 @@ public:
     if (num_edges_total == 0)
       return false;
 
-    // Allocate a new edge array.
-    std::vector<TEdge> edges(num_edges_total);
+    // Allocate a new edge array, reuse the memory of an edge array released by Clear() if possible.
+    std::vector<TEdge> edges = AllocateEdges(num_edges_total);
     // Fill in the edge array.
     bool result = false;
     TEdge *p_edge = edges.data();
@@ -353,6 +354,10 @@ public:
   }
 
   void Clear();
+  // Memory of the edges kept by Clear() for the next operation, in bytes.
+  size_t RetainedMemory() const;
+  // Free the memory kept by Clear() for the next operation.
+  void ReleaseRetainedMemory();
   IntRect GetBounds();
   // By default, when three or more vertices are collinear in input polygons (subject or clip), the Clipper object removes the 'inner' vertices before clipping.
   // When enabled the PreserveCollinear property prevents this default behavior to allow these inner vertices to appear in the solution.
@@ -361,6 +366,8 @@ public:
 protected:
   bool AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges);
   TEdge* AddBoundsToLML(TEdge *e, bool IsClosed);
+  // Take an edge array from m_edgesFree if available, fill it with num_edges default edges.
+  std::vector<TEdge> AllocateEdges(size_t num_edges);
   void Reset();
   TEdge* ProcessBound(TEdge* E, bool IsClockwise);
   TEdge* DescendToMin(TEdge *&E);
@@ -379,6 +386,9 @@ protected:
 
   // A vector of edges per each input path.
   std::vector<std::vector<TEdge>> m_edges;
+  // Edge arrays released by Clear(), kept for reuse by AddPath() / AddPaths(), so that
+  // a Clipper object reused for multiple operations does not allocate the edges again.
+  std::vector<std::vector<TEdge>> m_edgesFree;
   // Don't remove intermediate vertices of a collinear sequence of points.
   bool             m_PreserveCollinear;
   // Is any of the paths inserted by AddPath() or AddPaths() open?
@@ -390,8 +400,14 @@ class Clipper : public ClipperBase
 {
 public:
   Clipper(int initOptions = 0);
-  ~Clipper() { Clear(); }
+  ~Clipper();
+  // Clear the input paths and the output polygons. The memory of the edges, output points and output records
+  // is kept for the next operation, it is released by the destructor only.
   void Clear() { ClipperBase::Clear(); DisposeAllOutRecs(); }
+  // Memory of the edges, output records, output points and of the working lists kept for the next operation, in bytes.
+  size_t RetainedMemory() const;
+  // Free the memory kept for the next operation. The Clipper has to be cleared.
+  void ReleaseRetainedMemory();
   bool Execute(ClipType clipType,
       Paths &solution,
       PolyFillType fillType = pftEvenOdd) 
@@ -423,19 +439,28 @@ private:
   
   // Output polygons.
   std::vector<OutRec*>  m_PolyOuts;
+  // Output records released by DisposeAllOutRecs(), to be reused by CreateOutRec().
+  std::vector<OutRec*>  m_PolyOutsFree;
   // Output points, allocated by a continuous sets of m_OutPtsChunkSize.
+  // The chunks are retained by DisposeAllOutRecs() and refilled by the next operation.
   std::vector<OutPt*>   m_OutPts;
   // List of free output points, to be used before taking a point from m_OutPts or allocating a new chunk.
   OutPt                *m_OutPtsFree;
   size_t                m_OutPtsChunkSize;
+  // Index of the chunk of m_OutPts being filled, size_t(-1) if none.
+  size_t                m_OutPtsChunk;
+  // Number of points taken from the m_OutPtsChunk chunk.
   size_t                m_OutPtsChunkLast;
 
   std::vector<Join>     m_Joins;
   std::vector<Join>     m_GhostJoins;
   std::vector<IntersectNode> m_IntersectList;
   ClipType              m_ClipType;
-  // A priority queue (a binary heap) of Y coordinates.
-  std::priority_queue<cInt> m_Scanbeam;
+  // A priority queue (a binary max heap maintained by std::push_heap() / std::pop_heap()) of Y coordinates.
+  // Stored in a vector to keep its capacity between operations.
+  std::vector<cInt>     m_Scanbeam;
+  void                  ScanbeamPush(cInt y) { m_Scanbeam.emplace_back(y); std::push_heap(m_Scanbeam.begin(), m_Scanbeam.end()); }
+  cInt                  ScanbeamPop() { std::pop_heap(m_Scanbeam.begin(), m_Scanbeam.end()); cInt y = m_Scanbeam.back(); m_Scanbeam.pop_back(); return y; }
   // Maxima are collected by ProcessEdgesAtTopOfScanbeam(), consumed by ProcessHorizontal().
   std::vector<cInt>     m_Maxima;
   TEdge                *m_ActiveEdges;
@@ -520,6 +545,10 @@ public:
   void Execute(Paths& solution, double delta);
   void Execute(PolyTree& solution, double delta);
   void Clear();
+  // Memory of the working paths and of the cleaning Clipper kept for the next operation, in bytes.
+  size_t RetainedMemory() const;
+  // Free the memory kept for the next operation. The ClipperOffset has to be cleared.
+  void ReleaseRetainedMemory();
   double MiterLimit;
   double ArcTolerance;
   double ShortestEdgeLength;
@@ -535,6 +564,8 @@ private:
   // y: index of the lowest point in the lowest contour
   IntPoint m_lowest;
   PolyNode m_polyNodes;
+  // Clipper cleaning up the offset polygons, kept between Execute() calls to reuse its memory.
+  Clipper  m_clipper;
 
   void FixOrientations();
   void DoOffset(double delta);
@@ -111,30 +111,28 @@ static void export_graph_to_svg(const std::string
 
 SkeletalTrapezoidation::node_t& SkeletalTrapezoidation::makeNode(vd_t::vertex_type& vd_node, Point p)
 {
-    auto he_node_it = vd_node_to_he_node.find(&vd_node);
-    if (he_node_it == vd_node_to_he_node.end())
+    node_t*& he_node = vd_node_to_he_node[vd_node_idx(vd_node)];
+    if (! he_node)
     {
         graph.nodes.emplace_front(SkeletalTrapezoidationJoint(), p);
-        node_t& node = graph.nodes.front();
-        vd_node_to_he_node.emplace(&vd_node, &node);
-        return node;
-    }
-    else
-    {
-        return *he_node_it->second;
+        he_node = &graph.nodes.front();
     }
+    return *he_node;
+}
+
+void SkeletalTrapezoidation::resetVoronoiMapping(const vd_t &vd)
+{
+    this->vd = &vd;
+    vd_edge_to_he_edge.assign(vd.num_edges(), nullptr);
+    vd_node_to_he_node.assign(vd.num_vertices(), nullptr);
 }
 
 void SkeletalTrapezoidation::transferEdge(Point from, Point to, vd_t::edge_type& vd_edge, edge_t*& prev_edge, Point& start_source_point, Point& end_source_point, const std::vector<Segment>& segments)
 {
-    auto he_edge_it = vd_edge_to_he_edge.find(vd_edge.twin());
-    if (he_edge_it != vd_edge_to_he_edge.end())
+    if (edge_t* source_twin = vd_edge_to_he_edge[vd_edge_idx(*vd_edge.twin())]; source_twin)
     { // Twin segment(s) have already been made
-        edge_t* source_twin = he_edge_it->second;
-        assert(source_twin);
-        auto end_node_it = vd_node_to_he_node.find(vd_edge.vertex1());
-        assert(end_node_it != vd_node_to_he_node.end());
-        node_t* end_node = end_node_it->second;
+        node_t* end_node = vd_node_to_he_node[vd_node_idx(*vd_edge.vertex1())];
+        assert(end_node);
         for (edge_t* twin = source_twin; ;twin = twin->prev->twin->prev)
         {
             if(!twin)
@@ -232,7 +230,7 @@ void SkeletalTrapezoidation::transferEdge(Point from, Point to, vd_t::edge_type&
             }
         }
         assert(prev_edge);
-        vd_edge_to_he_edge.emplace(&vd_edge, prev_edge);
+        vd_edge_to_he_edge[vd_edge_idx(vd_edge)] = prev_edge;
     }
 }
 
@@ -587,9 +585,6 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
         return !grid.has_intersecting_edges();
     }());
 
-    vd_edge_to_he_edge.clear();
-    vd_node_to_he_node.clear();
-
     std::vector<Segment> segments;
     for (size_t poly_idx = 0; poly_idx < polys.size(); poly_idx++)
         for (size_t point_idx = 0; point_idx < polys[poly_idx].size(); point_idx++)
@@ -645,7 +640,8 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
     bool degenerated_voronoi_diagram = has_missing_voronoi_vertex || !is_voronoi_diagram_planar;
 
 process_voronoi_diagram:
-    assert(this->graph.edges.empty() && this->graph.nodes.empty() && this->vd_edge_to_he_edge.empty() && this->vd_node_to_he_node.empty());
+    assert(this->graph.edges.empty() && this->graph.nodes.empty());
+    this->resetVoronoiMapping(voronoi_diagram);
     for (vd_t::cell_type cell : voronoi_diagram.cells()) {
         if (!cell.incident_edge())
             continue; // There is no spoon
@@ -675,7 +671,7 @@ process_voronoi_diagram:
         assert(VoronoiUtils::p(starting_vonoroi_edge->vertex1()).x() <= std::numeric_limits<coord_t>::max() && VoronoiUtils::p(starting_vonoroi_edge->vertex1()).x() >= std::numeric_limits<coord_t>::lowest());
         assert(VoronoiUtils::p(starting_vonoroi_edge->vertex1()).y() <= std::numeric_limits<coord_t>::max() && VoronoiUtils::p(starting_vonoroi_edge->vertex1()).y() >= std::numeric_limits<coord_t>::lowest());
         transferEdge(start_source_point, VoronoiUtils::p(starting_vonoroi_edge->vertex1()).cast<coord_t>(), *starting_vonoroi_edge, prev_edge, start_source_point, end_source_point, segments);
-        node_t* starting_node = vd_node_to_he_node[starting_vonoroi_edge->vertex0()];
+        node_t* starting_node = vd_node_to_he_node[vd_node_idx(*starting_vonoroi_edge->vertex0())];
         starting_node->data.distance_to_boundary = 0;
 
         constexpr bool is_next_to_start_or_end = true;
@@ -718,8 +714,6 @@ process_voronoi_diagram:
 
         this->graph.edges.clear();
         this->graph.nodes.clear();
-        this->vd_edge_to_he_edge.clear();
-        this->vd_node_to_he_node.clear();
 
         goto process_voronoi_diagram;
     }
@@ -738,6 +732,13 @@ process_voronoi_diagram:
     assert(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(voronoi_diagram));
 #endif
 
+    // The mapping from the Voronoi diagram is not needed anymore, the diagram is going out of scope.
+    vd_edge_to_he_edge.clear();
+    vd_edge_to_he_edge.shrink_to_fit();
+    vd_node_to_he_node.clear();
+    vd_node_to_he_node.shrink_to_fit();
+    this->vd = nullptr;
+
     separatePointyQuadEndNodes();
 
     graph.collapseSmallEdges();
@@ -7,7 +7,7 @@
 #include <boost/polygon/voronoi.hpp>
 
 #include <memory> // smart pointers
-#include <unordered_map>
+#include <vector>
 #include <utility> // pair
 
 #include "utils/HalfEdgeGraph.hpp"
@@ -162,9 +162,15 @@ protected:
     /*!
      * mapping each voronoi VD edge to the corresponding halfedge HE edge
      * In case the result segment is discretized, we map the VD edge to the *last* HE edge
-     */
-    std::unordered_map<vd_t::edge_type*, edge_t*> vd_edge_to_he_edge;
-    std::unordered_map<vd_t::vertex_type*, node_t*> vd_node_to_he_node;
+     * Both are indexed by the index of the VD element in the VD being transferred (see vd_edge_idx() and vd_node_idx()),
+     * nullptr if not mapped yet.
+     */
+    std::vector<edge_t*> vd_edge_to_he_edge;
+    std::vector<node_t*> vd_node_to_he_node;
+    const vd_t *vd = nullptr;
+    size_t vd_edge_idx(const vd_t::edge_type &vd_edge) const { return &vd_edge - vd->edges().data(); }
+    size_t vd_node_idx(const vd_t::vertex_type &vd_node) const { return &vd_node - vd->vertices().data(); }
+    void resetVoronoiMapping(const vd_t &vd); //!< Start mapping the elements of \p vd, forget the previous mapping.
     node_t& makeNode(vd_t::vertex_type& vd_node, Point p); //!< Get the node which the VD node maps to, or create a new mapping if there wasn't any yet.
 
     /*!
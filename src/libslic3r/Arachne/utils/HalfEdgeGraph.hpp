@@ -5,8 +5,13 @@
 #define UTILS_HALF_EDGE_GRAPH_H
 
 
-#include <list>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 
 
@@ -15,14 +20,188 @@
 
 namespace Slic3r::Arachne
 {
+
+/*!
+ * Storage of the edges or nodes of a half-edge graph.
+ *
+ * Behaves like the subset of std::list used by the graph algorithms: the elements keep their address until erased,
+ * insertion at either end and erasure (also by a pointer to the element) are O(1) and the iteration order is the order
+ * of insertion. The elements are allocated in blocks of a fixed size and chained by 32-bit indices, so that adding an
+ * element does not call the allocator and neighbouring elements are close in memory. Erased slots are reused.
+ */
+template<class T>
+class HalfEdgeStorage
+{
+    static constexpr uint32_t BLOCK_BITS = 10;
+    static constexpr uint32_t BLOCK_SIZE = uint32_t(1) << BLOCK_BITS;
+    static constexpr uint32_t NONE       = uint32_t(-1);
+
+    // The element is the base of its slot, so that a pointer to the element is converted to its slot by a static_cast.
+    struct Slot : public T
+    {
+        template<typename... Args>
+        Slot(uint32_t idx, Args&&... args) : T(std::forward<Args>(args)...), slot_idx(idx) {}
+        // Not to be confused with the prev / next links of the half-edges.
+        uint32_t slot_idx;
+        uint32_t slot_prev = NONE;
+        uint32_t slot_next = NONE;
+    };
+
+public:
+    template<class Storage, class Value>
+    class iterator_t
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Value*;
+        using reference         = Value&;
+
+        iterator_t() = default;
+        iterator_t(Storage *storage, uint32_t idx) : m_storage(storage), m_idx(idx) {}
+        // Conversion of iterator to const_iterator.
+        template<class S, class V>
+        iterator_t(const iterator_t<S, V> &rhs) : m_storage(rhs.m_storage), m_idx(rhs.m_idx) {}
+
+        reference    operator*() const { return m_storage->slot(m_idx); }
+        pointer      operator->() const { return &m_storage->slot(m_idx); }
+        iterator_t&  operator++() { m_idx = m_storage->slot(m_idx).slot_next; return *this; }
+        iterator_t   operator++(int) { iterator_t out(*this); ++ *this; return out; }
+        iterator_t&  operator--() { m_idx = m_idx == NONE ? m_storage->m_back : m_storage->slot(m_idx).slot_prev; return *this; }
+        iterator_t   operator--(int) { iterator_t out(*this); -- *this; return out; }
+        bool         operator==(const iterator_t &rhs) const { return m_idx == rhs.m_idx; }
+        bool         operator!=(const iterator_t &rhs) const { return m_idx != rhs.m_idx; }
+
+    private:
+        template<class S, class V> friend class iterator_t;
+        friend class HalfEdgeStorage;
+        Storage  *m_storage { nullptr };
+        uint32_t  m_idx     { NONE };
+    };
+    using iterator       = iterator_t<HalfEdgeStorage, T>;
+    using const_iterator = iterator_t<const HalfEdgeStorage, const T>;
+
+    HalfEdgeStorage() = default;
+    HalfEdgeStorage(const HalfEdgeStorage &) = delete;
+    HalfEdgeStorage& operator=(const HalfEdgeStorage &) = delete;
+    ~HalfEdgeStorage() { this->clear(); }
+
+    bool            empty() const { return m_size == 0; }
+    size_t          size() const { return m_size; }
+
+    iterator        begin() { return iterator(this, m_front); }
+    iterator        end() { return iterator(this, NONE); }
+    const_iterator  begin() const { return const_iterator(this, m_front); }
+    const_iterator  end() const { return const_iterator(this, NONE); }
+
+    T&              front() { assert(m_front != NONE); return this->slot(m_front); }
+    T&              back() { assert(m_back != NONE); return this->slot(m_back); }
+    const T&        front() const { assert(m_front != NONE); return this->slot(m_front); }
+    const T&        back() const { assert(m_back != NONE); return this->slot(m_back); }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        Slot &s = this->allocate(std::forward<Args>(args)...);
+        s.slot_next = m_front;
+        if (m_front == NONE)
+            m_back = s.slot_idx;
+        else
+            this->slot(m_front).slot_prev = s.slot_idx;
+        m_front = s.slot_idx;
+        return s;
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        Slot &s = this->allocate(std::forward<Args>(args)...);
+        s.slot_prev = m_back;
+        if (m_back == NONE)
+            m_front = s.slot_idx;
+        else
+            this->slot(m_back).slot_next = s.slot_idx;
+        m_back = s.slot_idx;
+        return s;
+    }
+
+    // Erase the element, return the iterator following it.
+    iterator erase(const_iterator it) { return iterator(this, this->release(this->slot(it.m_idx))); }
+    // Erase the element pointed to, which has to be stored in this container.
+    void     erase(const T *elem) { this->release(static_cast<Slot&>(const_cast<T&>(*elem))); }
+
+    void clear()
+    {
+        for (uint32_t idx = m_front; idx != NONE;) {
+            Slot &s = this->slot(idx);
+            idx = s.slot_next;
+            s.~Slot();
+        }
+        for (Slot *block : m_blocks)
+            ::operator delete(block);
+        m_blocks.clear();
+        m_free.clear();
+        m_front = m_back = NONE;
+        m_size  = 0;
+        m_allocated = 0;
+    }
+
+private:
+    Slot&       slot(uint32_t idx) { return m_blocks[idx >> BLOCK_BITS][idx & (BLOCK_SIZE - 1)]; }
+    const Slot& slot(uint32_t idx) const { return m_blocks[idx >> BLOCK_BITS][idx & (BLOCK_SIZE - 1)]; }
+
+    template<typename... Args>
+    Slot& allocate(Args&&... args)
+    {
+        uint32_t idx;
+        if (! m_free.empty()) {
+            // Reuse a slot of an erased element.
+            idx = m_free.back();
+            m_free.pop_back();
+        } else {
+            assert(m_allocated < NONE);
+            if ((m_allocated & (BLOCK_SIZE - 1)) == 0)
+                m_blocks.emplace_back(static_cast<Slot*>(::operator new(sizeof(Slot) * BLOCK_SIZE)));
+            idx = m_allocated ++;
+        }
+        Slot *s = new (&this->slot(idx)) Slot(idx, std::forward<Args>(args)...);
+        ++ m_size;
+        return *s;
+    }
+
+    // Unlink and destroy the element, return the index of the element which followed it.
+    uint32_t release(Slot &s)
+    {
+        const uint32_t idx  = s.slot_idx;
+        const uint32_t prev = s.slot_prev;
+        const uint32_t next = s.slot_next;
+        (prev == NONE ? m_front : this->slot(prev).slot_next) = next;
+        (next == NONE ? m_back  : this->slot(next).slot_prev) = prev;
+        s.~Slot();
+        m_free.emplace_back(idx);
+        -- m_size;
+        return next;
+    }
+
+    std::vector<Slot*> m_blocks;
+    uint32_t           m_front     { NONE };
+    uint32_t           m_back      { NONE };
+    // Slots of the erased elements.
+    std::vector<uint32_t> m_free;
+    // Number of slots ever allocated.
+    uint32_t           m_allocated { 0 };
+    size_t             m_size      { 0 };
+};
+
 template<class node_data_t, class edge_data_t, class derived_node_t, class derived_edge_t> // types of data contained in nodes and edges
 class HalfEdgeGraph
 {
 public:
     using edge_t = derived_edge_t;
     using node_t = derived_node_t;
-    std::list<edge_t> edges;
-    std::list<node_t> nodes;
+    HalfEdgeStorage<edge_t> edges;
+    HalfEdgeStorage<node_t> nodes;
 };
 
 } // namespace Slic3r::Arachne
@@ -1,6 +1,12 @@
 #include "ClipperUtils.hpp"
 #include "Geometry.hpp"
 #include "ShortestPath.hpp"
+#include "AABBTreeIndirect.hpp"
+
+#include <memory>
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 
 // #define CLIPPER_UTILS_DEBUG
 
@@ -272,28 +278,88 @@ bool has_duplicate_points(const ClipperLib::PolyTree &polytree)
 }
 #endif
 
+// Clipper or ClipperOffset engine taken from a pool of engines of the current thread and returned to the pool when going out of scope.
+// A Clipper engine keeps its edges, output records and output points between operations, thus the pooled engines
+// save the memory allocations of the short boolean operations and offsets, which are called at a high rate from the slicing threads.
+// Nested operations take another engine from the pool.
+template<typename TEngine>
+class PooledClipper
+{
+public:
+    PooledClipper() {
+        std::vector<std::unique_ptr<TEngine>> &engines = pool().local();
+        if (engines.empty())
+            m_engine = std::make_unique<TEngine>();
+        else {
+            m_engine = std::move(engines.back());
+            engines.pop_back();
+        }
+    }
+    ~PooledClipper() {
+        // Return the engine to the pool in its default state.
+        reset(*m_engine);
+        if (std::vector<std::unique_ptr<TEngine>> &engines = pool().local(); engines.size() < max_engines_per_thread)
+            engines.emplace_back(std::move(m_engine));
+    }
+    PooledClipper(const PooledClipper &) = delete;
+    PooledClipper& operator=(const PooledClipper &) = delete;
+
+    TEngine& operator*()  { return *m_engine; }
+    TEngine* operator->() { return m_engine.get(); }
+
+private:
+    // Deeper nesting of the Clipper operations than this is not expected, the engines above the limit are released.
+    static constexpr const size_t max_engines_per_thread = 4;
+    // An engine returned to the pool keeps at most this much memory, so that a single huge operation
+    // does not hold its working memory for the rest of the process.
+    static constexpr const size_t max_retained_memory = 1024 * 1024;
+
+    static tbb::enumerable_thread_specific<std::vector<std::unique_ptr<TEngine>>>& pool() {
+        static tbb::enumerable_thread_specific<std::vector<std::unique_ptr<TEngine>>> engines;
+        return engines;
+    }
+    static void reset(ClipperLib::Clipper &clipper) {
+        clipper.Clear();
+        if (clipper.RetainedMemory() > max_retained_memory)
+            clipper.ReleaseRetainedMemory();
+        clipper.ReverseSolution(false);
+        clipper.StrictlySimple(false);
+        clipper.PreserveCollinear(false);
+    }
+    static void reset(ClipperLib::ClipperOffset &co) {
+        co.Clear();
+        if (co.RetainedMemory() > max_retained_memory)
+            co.ReleaseRetainedMemory();
+        co.MiterLimit         = 2.;
+        co.ArcTolerance       = 0.25;
+        co.ShortestEdgeLength = 0.;
+    }
+
+    std::unique_ptr<TEngine> m_engine;
+};
+
 // Offset CCW contours outside, CW contours (holes) inside.
 // Don't calculate union of the output paths.
 template<typename PathsProvider, ClipperLib::EndType endType = ClipperLib::etClosedPolygon>
 static ClipperLib::Paths raw_offset(PathsProvider &&paths, double offset, ClipperLib::JoinType joinType, double miterLimit)
 {
-    ClipperLib::ClipperOffset co;
+    PooledClipper<ClipperLib::ClipperOffset> co;
     ClipperLib::Paths out;
     out.reserve(paths.size());
     ClipperLib::Paths out_this;
     if (joinType == jtRound)
-        co.ArcTolerance = miterLimit;
+        co->ArcTolerance = miterLimit;
     else
-        co.MiterLimit = miterLimit;
-    co.ShortestEdgeLength = double(std::abs(offset * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+        co->MiterLimit = miterLimit;
+    co->ShortestEdgeLength = double(std::abs(offset * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
     for (const ClipperLib::Path &path : paths) {
-        co.Clear();
+        co->Clear();
         // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
         // contours will be CCW oriented even though the input paths are CW oriented.
         // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-        co.AddPath(path, joinType, endType);
+        co->AddPath(path, joinType, endType);
         bool ccw = endType == ClipperLib::etClosedPolygon ? ClipperLib::Orientation(path) : true;
-        co.Execute(out_this, ccw ? offset : - offset);
+        co->Execute(out_this, ccw ? offset : - offset);
         if (! ccw) {
             // Reverse the resulting contours.
             for (ClipperLib::Path &path : out_this)
@@ -311,21 +377,108 @@ static ClipperLib::Paths safety_offset(PathsProvider &&paths)
     return raw_offset(std::forward<PathsProvider>(paths), ClipperSafetyOffset, DefaultJoinType, DefaultMiterLimit);
 }
 
+// Minimum number of clipping paths, for which clipper_do() culls the clipping paths by the bounding box of the subject.
+static constexpr const size_t ClipperCullingMinPaths = 4;
+
+template<typename PathsProvider>
+static BoundingBox get_extents_paths(PathsProvider &&paths)
+{
+    BoundingBox bbox;
+    for (const Points &path : paths)
+        if (! path.empty()) {
+            if (! bbox.defined) {
+                bbox.min = bbox.max = path.front();
+                bbox.defined = true;
+            }
+            for (const Point &pt : path) {
+                bbox.min = bbox.min.cwiseMin(pt);
+                bbox.max = bbox.max.cwiseMax(pt);
+            }
+        }
+    return bbox;
+}
+
+// Collect the paths overlapping bbox into out, extend out_bbox with their bounding boxes.
+// Returns false if all the paths overlap bbox, thus there is nothing to cull.
+// A path with its bounding box not overlapping the bounding box of the subject does not change the winding number
+// of any point of the subject, thus it does not change the result of an intersection or a difference with the subject.
+template<typename PathsProvider>
+static bool cull_paths_outside_bbox(PathsProvider &&paths, const BoundingBox &bbox, std::vector<const Points*> &out, BoundingBox &out_bbox)
+{
+    out.clear();
+    out.reserve(paths.size());
+    for (const Points &path : paths) {
+        BoundingBox path_bbox = get_extents_paths(ClipperUtils::SinglePathProvider(path));
+        if (path_bbox.defined && bbox.overlap(path_bbox)) {
+            out.emplace_back(&path);
+            out_bbox.merge(path_bbox);
+        }
+    }
+    return out.size() < paths.size();
+}
+
 template<class TResult, class TSubj, class TClip>
-TResult clipper_do(
+TResult clipper_do_unculled(
     const ClipperLib::ClipType     clipType,
     TSubj &&                       subject,
     TClip &&                       clip,
     const ClipperLib::PolyFillType fillType)
 {
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
-    clipper.AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
+    PooledClipper<ClipperLib::Clipper> clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    clipper->AddPaths(std::forward<TClip>(clip),    ClipperLib::ptClip,    true);
     TResult retval;
-    clipper.Execute(clipType, retval, fillType, fillType);
+    clipper->Execute(clipType, retval, fillType, fillType);
     return retval;
 }
 
+// Safety offset of the clipping paths of an intersection or a difference with the subject.
+// The clipping paths not overlapping the subject are culled before applying the offset to them.
+template<class TSubj, class TClip>
+static ClipperLib::Paths safety_offset_clip(const TSubj &subject, TClip &&clip)
+{
+    if (clip.size() >= ClipperCullingMinPaths) {
+        // The safety offset uses miter joins, a vertex may be moved by up to ClipperSafetyOffset * DefaultMiterLimit.
+        BoundingBox subject_bbox = get_extents_paths(subject);
+        subject_bbox.offset(ClipperSafetyOffset * DefaultMiterLimit + 1.);
+        std::vector<const Points*> clip_culled;
+        BoundingBox                clip_bbox;
+        if (subject_bbox.defined && cull_paths_outside_bbox(clip, subject_bbox, clip_culled, clip_bbox))
+            return safety_offset(ClipperUtils::PointsPtrProvider(clip_culled));
+    }
+    return safety_offset(std::forward<TClip>(clip));
+}
+
+// Intersection and difference cull the clipping paths not overlapping the bounding box of the subject,
+// intersection also culls the subject paths not overlapping the bounding box of the remaining clipping paths.
+template<class TResult, class TSubj, class TClip>
+TResult clipper_do(
+    const ClipperLib::ClipType     clipType,
+    TSubj &&                       subject,
+    TClip &&                       clip,
+    const ClipperLib::PolyFillType fillType)
+{
+    if ((clipType == ClipperLib::ctIntersection || clipType == ClipperLib::ctDifference) && clip.size() >= ClipperCullingMinPaths)
+        if (const BoundingBox subject_bbox = get_extents_paths(subject); subject_bbox.defined) {
+            std::vector<const Points*> clip_culled;
+            BoundingBox                clip_bbox;
+            const bool                 clip_was_culled = cull_paths_outside_bbox(clip, subject_bbox, clip_culled, clip_bbox);
+            if (clipType == ClipperLib::ctIntersection) {
+                if (clip_culled.empty())
+                    return TResult();
+                std::vector<const Points*> subject_culled;
+                BoundingBox                subject_culled_bbox;
+                if (subject.size() >= ClipperCullingMinPaths && cull_paths_outside_bbox(subject, clip_bbox, subject_culled, subject_culled_bbox))
+                    return clip_was_culled ?
+                        clipper_do_unculled<TResult>(clipType, ClipperUtils::PointsPtrProvider(subject_culled), ClipperUtils::PointsPtrProvider(clip_culled), fillType) :
+                        clipper_do_unculled<TResult>(clipType, ClipperUtils::PointsPtrProvider(subject_culled), std::forward<TClip>(clip), fillType);
+            }
+            if (clip_was_culled)
+                return clipper_do_unculled<TResult>(clipType, std::forward<TSubj>(subject), ClipperUtils::PointsPtrProvider(clip_culled), fillType);
+        }
+    return clipper_do_unculled<TResult>(clipType, std::forward<TSubj>(subject), std::forward<TClip>(clip), fillType);
+}
+
 template<class TResult, class TSubj, class TClip>
 TResult clipper_do(
     const ClipperLib::ClipType     clipType,
@@ -337,7 +490,7 @@ TResult clipper_do(
     // Safety offset only allowed on intersection and difference.
     assert(do_safety_offset == ApplySafetyOffset::No || clipType != ClipperLib::ctUnion);
     return do_safety_offset == ApplySafetyOffset::Yes ? 
-        clipper_do<TResult>(clipType, std::forward<TSubj>(subject), safety_offset(std::forward<TClip>(clip)), fillType) :
+        clipper_do<TResult>(clipType, std::forward<TSubj>(subject), safety_offset_clip(subject, std::forward<TClip>(clip)), fillType) :
         clipper_do<TResult>(clipType, std::forward<TSubj>(subject), std::forward<TClip>(clip), fillType);
 }
 
@@ -347,10 +500,10 @@ TResult clipper_union(
     // fillType pftNonZero and pftPositive "should" produce the same result for "normalized with implicit union" set of polygons
     const ClipperLib::PolyFillType fillType = ClipperLib::pftNonZero)
 {
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
+    PooledClipper<ClipperLib::Clipper> clipper;
+    clipper->AddPaths(std::forward<TSubj>(subject), ClipperLib::ptSubject, true);
     TResult retval;
-    clipper.Execute(ClipperLib::ctUnion, retval, fillType, fillType);
+    clipper->Execute(ClipperLib::ctUnion, retval, fillType, fillType);
     return retval;
 }
 
@@ -388,12 +541,12 @@ static TResult shrink_paths(PathsProvider &&paths, double offset, ClipperLib::Jo
     assert(offset > 0);
     TResult out;
     if (auto raw = raw_offset(std::forward<PathsProvider>(paths), - offset, joinType, miterLimit); ! raw.empty()) {
-        ClipperLib::Clipper clipper;
-        clipper.AddPaths(raw, ClipperLib::ptSubject, true);
-        ClipperLib::IntRect r = clipper.GetBounds();
-        clipper.AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
-        clipper.ReverseSolution(true);
-        clipper.Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
+        PooledClipper<ClipperLib::Clipper> clipper;
+        clipper->AddPaths(raw, ClipperLib::ptSubject, true);
+        ClipperLib::IntRect r = clipper->GetBounds();
+        clipper->AddPath({ { r.left - 10, r.bottom + 10 }, { r.right + 10, r.bottom + 10 }, { r.right + 10, r.top - 10 }, { r.left - 10, r.top - 10 } }, ClipperLib::ptSubject, true);
+        clipper->ReverseSolution(true);
+        clipper->Execute(ClipperLib::ctUnion, out, ClipperLib::pftNegative, ClipperLib::pftNegative);
         remove_outermost_polygon(out);
     }
     return out;
@@ -427,14 +580,14 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const double
     // 1) Offset the outer contour.
     ClipperLib::Paths contours;
     {
-        ClipperLib::ClipperOffset co;
+        PooledClipper<ClipperLib::ClipperOffset> co;
         if (joinType == jtRound)
-            co.ArcTolerance = miterLimit;
+            co->ArcTolerance = miterLimit;
         else
-            co.MiterLimit = miterLimit;
-        co.ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-        co.AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
-        co.Execute(contours, delta);
+            co->MiterLimit = miterLimit;
+        co->ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+        co->AddPath(expoly.contour.points, joinType, ClipperLib::etClosedPolygon);
+        co->Execute(contours, delta);
     }
     if (contours.empty())
         // No need to try to offset the holes.
@@ -448,18 +601,18 @@ static int offset_expolygon_inner(const Slic3r::ExPolygon &expoly, const double
         ClipperLib::Paths holes;
         {
             for (const Polygon &hole : expoly.holes) {
-                ClipperLib::ClipperOffset co;
+                PooledClipper<ClipperLib::ClipperOffset> co;
                 if (joinType == jtRound)
-                    co.ArcTolerance = miterLimit;
+                    co->ArcTolerance = miterLimit;
                 else
-                    co.MiterLimit = miterLimit;
-                co.ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-                co.AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
+                    co->MiterLimit = miterLimit;
+                co->ShortestEdgeLength = double(std::abs(delta * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+                co->AddPath(hole.points, joinType, ClipperLib::etClosedPolygon);
                 ClipperLib::Paths out2;
                 // Execute reorients the contours so that the outer most contour has a positive area. Thus the output
                 // contours will be CCW oriented even though the input paths are CW oriented.
                 // Offset is applied after contour reorientation, thus the signum of the offset value is reversed.
-                co.Execute(out2, - delta);
+                co->Execute(out2, - delta);
                 append(holes, std::move(out2));
             }
         }
@@ -703,7 +856,7 @@ inline ClipperLib::PolyTree clipper_do_polytree(
     assert(do_safety_offset == ApplySafetyOffset::No || clipType != ClipperLib::ctUnion);
 
     if (do_safety_offset == ApplySafetyOffset::Yes) {
-        ClipperLib::PolyTree retval = clipper_do_polytree(clipType, std::forward<PathProvider1>(subject), safety_offset(std::forward<PathProvider2>(clip)), fillType);
+        ClipperLib::PolyTree retval = clipper_do_polytree(clipType, std::forward<PathProvider1>(subject), safety_offset_clip(subject, std::forward<PathProvider2>(clip)), fillType);
         // if safety_offset_, remove too small polygons & holes
         for (int idx_poly = 0; idx_poly < retval.ChildCount(); ++idx_poly) {
             ClipperLib::PolyNode* ex_polygon = retval.Childs[idx_poly];
@@ -814,6 +967,79 @@ Slic3r::ExPolygons intersection_ex(const Slic3r::Surfaces &subject, const Slic3r
     { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::SurfacesProvider(subject), ClipperUtils::SurfacesProvider(clip), do_safety_offset); }
 Slic3r::ExPolygons intersection_ex(const Slic3r::SurfacesPtr &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
     { return _clipper_ex(ClipperLib::ctIntersection, ClipperUtils::SurfacesPtrProvider(subject), ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+
+template<typename TClip>
+static std::vector<ExPolygons> _clipper_ex_batch(ClipperLib::ClipType clipType, const ExPolygons &subjects, TClip &&clip, ApplySafetyOffset do_safety_offset)
+{
+    assert(clipType == ClipperLib::ctIntersection || clipType == ClipperLib::ctDifference);
+    std::vector<ExPolygons> out(subjects.size());
+    if (subjects.empty())
+        return out;
+
+    // Collect the clipping paths, apply the safety offset to all of them at once.
+    ClipperLib::Paths          clip_offsetted;
+    std::vector<const Points*> clip_paths;
+    if (do_safety_offset == ApplySafetyOffset::Yes) {
+        clip_offsetted = safety_offset(std::forward<TClip>(clip));
+        clip_paths.reserve(clip_offsetted.size());
+        for (const Points &path : clip_offsetted)
+            clip_paths.emplace_back(&path);
+    } else {
+        clip_paths.reserve(clip.size());
+        for (const Points &path : clip)
+            clip_paths.emplace_back(&path);
+    }
+
+    // Index the clipping paths by their bounding boxes.
+    using Tree = AABBTreeIndirect::Tree<2, coord_t>;
+    struct PathBBox {
+        size_t                   path_idx;
+        Tree::BoundingBox        path_bbox;
+        size_t                   idx()      const { return path_idx; }
+        const Tree::BoundingBox& bbox()     const { return path_bbox; }
+        Tree::VectorType         centroid() const { return ((path_bbox.min().template cast<int64_t>() + path_bbox.max().template cast<int64_t>()) / 2).template cast<coord_t>(); }
+    };
+    std::vector<PathBBox> bboxes;
+    bboxes.reserve(clip_paths.size());
+    for (size_t i = 0; i < clip_paths.size(); ++ i)
+        if (BoundingBox bbox = get_extents_paths(ClipperUtils::SinglePathProvider(*clip_paths[i])); bbox.defined)
+            bboxes.push_back({ i, Tree::BoundingBox(bbox.min, bbox.max) });
+    Tree tree;
+    tree.build(std::move(bboxes));
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, subjects.size()),
+        [clipType, &subjects, &clip_paths, &tree, &out](const tbb::blocked_range<size_t> &range) {
+            std::vector<size_t>        overlapping;
+            std::vector<const Points*> clip_overlapping;
+            for (size_t i = range.begin(); i < range.end(); ++ i) {
+                const ExPolygon &subject = subjects[i];
+                BoundingBox      bbox    = get_extents(subject.contour);
+                overlapping.clear();
+                AABBTreeIndirect::traverse(tree, AABBTreeIndirect::intersecting(Tree::BoundingBox(bbox.min, bbox.max)),
+                    [&overlapping](size_t idx) { overlapping.emplace_back(idx); });
+                if (overlapping.empty() && clipType == ClipperLib::ctIntersection)
+                    continue;
+                // A difference with no overlapping clipping path still runs Clipper on the subject alone,
+                // so that the result is normalized the same way diff_ex() normalizes it.
+                // Pass the clipping paths to Clipper in their original order.
+                std::sort(overlapping.begin(), overlapping.end());
+                clip_overlapping.clear();
+                for (size_t idx : overlapping)
+                    clip_overlapping.emplace_back(clip_paths[idx]);
+                out[i] = _clipper_ex(clipType, ClipperUtils::ExPolygonProvider(subject), ClipperUtils::PointsPtrProvider(clip_overlapping), ApplySafetyOffset::No);
+            }
+        });
+    return out;
+}
+
+std::vector<Slic3r::ExPolygons> intersection_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex_batch(ClipperLib::ctIntersection, subjects, ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+std::vector<Slic3r::ExPolygons> intersection_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex_batch(ClipperLib::ctIntersection, subjects, ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
+std::vector<Slic3r::ExPolygons> diff_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex_batch(ClipperLib::ctDifference, subjects, ClipperUtils::PolygonsProvider(clip), do_safety_offset); }
+std::vector<Slic3r::ExPolygons> diff_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset)
+    { return _clipper_ex_batch(ClipperLib::ctDifference, subjects, ClipperUtils::ExPolygonsProvider(clip), do_safety_offset); }
 // May be used to "heal" unusual models (3DLabPrints etc.) by providing fill_type (pftEvenOdd, pftNonZero, pftPositive, pftNegative).
 Slic3r::ExPolygons union_ex(const Slic3r::Polygons &subject, ClipperLib::PolyFillType fill_type)
     { return _clipper_ex(ClipperLib::ctUnion, ClipperUtils::PolygonsProvider(subject), ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No, fill_type); }
@@ -884,16 +1110,16 @@ Polylines _clipper_pl_open(ClipperLib::ClipType clipType, PathsProvider1 &&subje
     }
 
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    PooledClipper<ClipperLib::Clipper> clipper;
+    clipper->Clear();
 
     // add polygons
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, false);
-    clipper.AddPaths(input_clip, ClipperLib::ptClip, true);
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, false);
+    clipper->AddPaths(input_clip, ClipperLib::ptClip, true);
 
     // perform operation
     ClipperLib::PolyTree retval;
-    clipper.Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    clipper->Execute(clipType, retval, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 
     //restore good y
     std::vector<ClipperLib::PolyNode*> to_check;
@@ -1276,11 +1502,11 @@ Polygons simplify_polygons(const Polygons &subject, bool preserve_collinear)
 {
     ClipperLib::Paths output;
     if (preserve_collinear) {
-        ClipperLib::Clipper c;
-        c.PreserveCollinear(true);
-        c.StrictlySimple(true);
-        c.AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
-        c.Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        PooledClipper<ClipperLib::Clipper> c;
+        c->PreserveCollinear(true);
+        c->StrictlySimple(true);
+        c->AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
+        c->Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     } else {
         output = ClipperLib::SimplifyPolygons(ClipperUtils::PolygonsProvider(subject), ClipperLib::pftNonZero);
     }
@@ -1295,11 +1521,11 @@ ExPolygons simplify_polygons_ex(const Polygons &subject, bool preserve_collinear
         return union_ex(simplify_polygons(subject, false));
 
     ClipperLib::PolyTree polytree;    
-    ClipperLib::Clipper c;
-    c.PreserveCollinear(true);
-    c.StrictlySimple(true);
-    c.AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    PooledClipper<ClipperLib::Clipper> c;
+    c->PreserveCollinear(true);
+    c->StrictlySimple(true);
+    c->AddPaths(ClipperUtils::PolygonsProvider(subject), ClipperLib::ptSubject, true);
+    c->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     
     // convert into ExPolygons
     return PolyTreeToExPolygons(std::move(polytree));
@@ -1308,12 +1534,12 @@ ExPolygons simplify_polygons_ex(const Polygons &subject, bool preserve_collinear
 Polygons top_level_islands(const Slic3r::Polygons &polygons)
 {
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    PooledClipper<ClipperLib::Clipper> clipper;
+    clipper->Clear();
     // perform union
-    clipper.AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
+    clipper->AddPaths(ClipperUtils::PolygonsProvider(polygons), ClipperLib::ptSubject, true);
     ClipperLib::PolyTree polytree;
-    clipper.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
+    clipper->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
     // Convert only the top level islands to the output.
     Polygons out;
     out.reserve(polytree.ChildCount());
@@ -1332,10 +1558,10 @@ ClipperLib::Paths fix_after_outer_offset(
 {
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-	  	clipper.AddPath(input, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+		PooledClipper<ClipperLib::Clipper> clipper;
+	  	clipper->AddPath(input, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 	}
     return solution;
 }
@@ -1350,16 +1576,16 @@ ClipperLib::Paths fix_after_inner_offset(
 {
   	ClipperLib::Paths solution;
   	if (! input.empty()) {
-		ClipperLib::Clipper clipper;
-		clipper.AddPath(input, ClipperLib::ptSubject, true);
-		ClipperLib::IntRect r = clipper.GetBounds();
+		PooledClipper<ClipperLib::Clipper> clipper;
+		clipper->AddPath(input, ClipperLib::ptSubject, true);
+		ClipperLib::IntRect r = clipper->GetBounds();
 		r.left -= 10; r.top -= 10; r.right += 10; r.bottom += 10;
 		if (filltype == ClipperLib::pftPositive)
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.left, r.top), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.right, r.bottom) }, ClipperLib::ptSubject, true);
 		else
-			clipper.AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
-		clipper.ReverseSolution(reverse_result);
-		clipper.Execute(ClipperLib::ctUnion, solution, filltype, filltype);
+			clipper->AddPath({ ClipperLib::IntPoint(r.left, r.bottom), ClipperLib::IntPoint(r.right, r.bottom), ClipperLib::IntPoint(r.right, r.top), ClipperLib::IntPoint(r.left, r.top) }, ClipperLib::ptSubject, true);
+		clipper->ReverseSolution(reverse_result);
+		clipper->Execute(ClipperLib::ctUnion, solution, filltype, filltype);
 		if (! solution.empty())
 			solution.erase(solution.begin());
 	}
@@ -1538,11 +1764,11 @@ Polygons variable_offset_inner(const ExPolygon &expoly, const std::vector<std::v
 	if (holes.empty())
 		output = std::move(contours);
 	else {
-		ClipperLib::Clipper clipper;
-		clipper.Clear();
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
-		clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		PooledClipper<ClipperLib::Clipper> clipper;
+		clipper->Clear();
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	}
 
 	return to_polygons(std::move(output));
@@ -1580,11 +1806,11 @@ for (const std::vector<float>& ds : deltas)
 	if (holes.empty())
 		output = std::move(contours);
 	else {
-		ClipperLib::Clipper clipper;
-		clipper.Clear();
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
-		clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		PooledClipper<ClipperLib::Clipper> clipper;
+		clipper->Clear();
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
+		clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	}
 
 	return to_polygons(std::move(output));
@@ -1624,11 +1850,11 @@ for (const std::vector<float>& ds : deltas)
 		for (ClipperLib::Path &path : contours) 
 			output.emplace_back(std::move(path));
 	} else {
-		ClipperLib::Clipper clipper;
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
+		PooledClipper<ClipperLib::Clipper> clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
 	    ClipperLib::PolyTree polytree;
-		clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	    output = PolyTreeToExPolygons(std::move(polytree));
 	}
 
@@ -1676,11 +1902,11 @@ ExPolygons variable_offset_inner_ex(const ExPolygon &expoly, const std::vector<s
 		for (ClipperLib::Path &path : contours) 
 			output.emplace_back(std::move(path));
 	} else {
-		ClipperLib::Clipper clipper;
-		clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-		clipper.AddPaths(holes, ClipperLib::ptClip, true);
+		PooledClipper<ClipperLib::Clipper> clipper;
+		clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+		clipper->AddPaths(holes, ClipperLib::ptClip, true);
 	    ClipperLib::PolyTree polytree;
-		clipper.Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		clipper->Execute(ClipperLib::ctDifference, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 	    output = PolyTreeToExPolygons(std::move(polytree));
 	}
 
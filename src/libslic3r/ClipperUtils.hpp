@@ -298,6 +298,33 @@ namespace ClipperUtils {
         size_t             m_size;
     };
 
+    // Paths referenced by pointers, for example a subset of the paths of another provider.
+    class PointsPtrProvider {
+    public:
+        PointsPtrProvider(const std::vector<const Points*> &paths) : m_paths(paths) {}
+
+        struct iterator : public PathsProviderIteratorBase {
+        public:
+            explicit iterator(std::vector<const Points*>::const_iterator it) : m_it(it) {}
+            const Points& operator*() const { return **m_it; }
+            bool operator==(const iterator &rhs) const { return m_it == rhs.m_it; }
+            bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+            const Points& operator++(int) { return **(m_it ++); }
+            iterator& operator++() { ++ m_it; return *this; }
+        private:
+            std::vector<const Points*>::const_iterator m_it;
+        };
+
+        iterator cbegin() const { return iterator(m_paths.begin()); }
+        iterator begin()  const { return this->cbegin(); }
+        iterator cend()   const { return iterator(m_paths.end()); }
+        iterator end()    const { return this->cend(); }
+        size_t   size()   const { return m_paths.size(); }
+
+    private:
+        const std::vector<const Points*> &m_paths;
+    };
+
     using ZPoint = Vec3i32;
     using ZPoints = std::vector<Vec3i32>;
 
@@ -446,6 +473,16 @@ Slic3r::ExPolygons intersection_ex(const Slic3r::Surfaces &subject, const Slic3r
 Slic3r::ExPolygons intersection_ex(const Slic3r::Surfaces &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 Slic3r::ExPolygons intersection_ex(const Slic3r::Surfaces &subject, const Slic3r::Surfaces &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
 Slic3r::ExPolygons intersection_ex(const Slic3r::SurfacesPtr &subject, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+// Batched intersection_ex() / diff_ex(): each of the subjects is clipped with the same set of clipping polygons, one result per subject.
+// The clipping polygons are indexed by their bounding boxes once and only those overlapping a subject are passed to Clipper,
+// the subjects are processed in parallel. A subject not overlapping any clipping polygon is dropped by the intersection
+// and normalized by the difference, the results are the same as those of intersection_ex() / diff_ex() of each subject.
+// Safety offset is applied to the clipping polygons only.
+std::vector<Slic3r::ExPolygons> intersection_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+std::vector<Slic3r::ExPolygons> intersection_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+std::vector<Slic3r::ExPolygons> diff_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::Polygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+std::vector<Slic3r::ExPolygons> diff_ex_batch(const Slic3r::ExPolygons &subjects, const Slic3r::ExPolygons &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+
 Slic3r::Polylines  intersection_pl(const Slic3r::Polylines &subject, const Slic3r::Polygon &clip);
 Slic3r::Polylines  intersection_pl(const Slic3r::Polyline &subject, const Slic3r::Polygons &clip);
 Slic3r::Polylines  intersection_pl(const Slic3r::Polylines &subject, const Slic3r::Polygons &clip);
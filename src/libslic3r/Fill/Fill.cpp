@@ -14,6 +14,8 @@
 #include "FillLightning.hpp"
 #include "FillConcentric.hpp"
 
+#include <tbb/parallel_for.h>
+
 namespace Slic3r {
 
 struct SurfaceFillParams : FillParams
@@ -523,206 +525,229 @@ void Layer::make_fills(FillAdaptive::Octree* adaptive_fill_octree, FillAdaptive:
         }
         fills_by_priority.clear();
     };
-    //surface_fills is sorted by region_id
-    size_t current_region_id = -1;
-    for (SurfaceFill &surface_fill : surface_fills) {
-        // store the region fill when changing region. 
-        if (current_region_id != size_t(-1) && current_region_id != surface_fill.region_id) {
-            store_fill(current_region_id);
-        }
-        current_region_id = surface_fill.region_id;
-        const LayerRegion* layerm = this->m_regions[surface_fill.region_id];
+    // The groups are independent, they are filled in parallel, each one into its own collection.
+    struct SurfaceFillOutput {
+        ExtrusionEntityCollection fills;
+        // Was the filler called at least once?
+        bool                      filled = false;
+    };
+    std::vector<SurfaceFillOutput> surface_fill_outputs(surface_fills.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, surface_fills.size(), 1),
+        [this, &surface_fills, &surface_fill_outputs, &bbox, &perimeter_generator, adaptive_fill_octree, support_fill_octree, lightning_generator]
+        (const tbb::blocked_range<size_t> &range) {
+            for (size_t surface_fill_idx = range.begin(); surface_fill_idx < range.end(); ++ surface_fill_idx) {
+                SurfaceFill       &surface_fill = surface_fills[surface_fill_idx];
+                SurfaceFillOutput &output       = surface_fill_outputs[surface_fill_idx];
+                const LayerRegion* layerm = this->m_regions[surface_fill.region_id];
         
-        // Create the filler object.
-        std::unique_ptr<Fill> f = std::unique_ptr<Fill>(Fill::new_from_type(surface_fill.params.pattern));
-        f->set_bounding_box(bbox);
-        f->layer_id = this->id();
-        f->z        = this->print_z;
-        f->angle    = surface_fill.params.angle;
-        f->can_angle_cross   = surface_fill.params.can_angle_cross;
-        f->adapt_fill_octree = (surface_fill.params.pattern == ipSupportCubic) ? support_fill_octree : adaptive_fill_octree;
-
-        if (surface_fill.params.pattern == ipLightning)
-            dynamic_cast<FillLightning::Filler*>(f.get())->generator = lightning_generator;
-
-        if (perimeter_generator.value == PerimeterGeneratorType::Arachne && surface_fill.params.pattern == ipConcentric) {
-            FillConcentric *fill_concentric = dynamic_cast<FillConcentric *>(f.get());
-            assert(fill_concentric != nullptr);
-            fill_concentric->print_config        = &this->object()->print()->config();
-            fill_concentric->print_object_config = &this->object()->config();
-        }
+                // Create the filler object.
+                std::unique_ptr<Fill> f = std::unique_ptr<Fill>(Fill::new_from_type(surface_fill.params.pattern));
+                f->set_bounding_box(bbox);
+                f->layer_id = this->id();
+                f->z        = this->print_z;
+                f->angle    = surface_fill.params.angle;
+                f->can_angle_cross   = surface_fill.params.can_angle_cross;
+                f->adapt_fill_octree = (surface_fill.params.pattern == ipSupportCubic) ? support_fill_octree : adaptive_fill_octree;
+
+                if (surface_fill.params.pattern == ipLightning)
+                    dynamic_cast<FillLightning::Filler*>(f.get())->generator = lightning_generator;
+
+                if (perimeter_generator.value == PerimeterGeneratorType::Arachne && surface_fill.params.pattern == ipConcentric) {
+                    FillConcentric *fill_concentric = dynamic_cast<FillConcentric *>(f.get());
+                    assert(fill_concentric != nullptr);
+                    fill_concentric->print_config        = &this->object()->print()->config();
+                    fill_concentric->print_object_config = &this->object()->config();
+                }
 
-        // calculate flow spacing for infill pattern generation
-        //FIXME FLOW decide if using surface_fill.params.flow.bridge() or surface_fill.params.bridge (default but deleted)
-        bool using_internal_flow = ! surface_fill.surface.has_fill_solid() && !surface_fill.params.flow.bridge();
-        //init spacing, it may also use & modify a bit the surface_fill.params, so most of these should be set before.
-        // note that the bridge overlap is applied here via the rectilinear init_spacing. 
-        f->init_spacing(surface_fill.params.spacing, surface_fill.params);
-        double link_max_length = 0.;
-        //FIXME FLOW decide if using surface_fill.params.flow.bridge() or surface_fill.params.bridge (default but deleted)
-        if (! surface_fill.params.flow.bridge()) {
+                // calculate flow spacing for infill pattern generation
+                //FIXME FLOW decide if using surface_fill.params.flow.bridge() or surface_fill.params.bridge (default but deleted)
+                bool using_internal_flow = ! surface_fill.surface.has_fill_solid() && !surface_fill.params.flow.bridge();
+                //init spacing, it may also use & modify a bit the surface_fill.params, so most of these should be set before.
+                // note that the bridge overlap is applied here via the rectilinear init_spacing. 
+                f->init_spacing(surface_fill.params.spacing, surface_fill.params);
+                double link_max_length = 0.;
+                //FIXME FLOW decide if using surface_fill.params.flow.bridge() or surface_fill.params.bridge (default but deleted)
+                if (! surface_fill.params.flow.bridge()) {
 #if 0
-            link_max_length = layerm.region().config().get_abs_value(surface.is_external() ? "external_fill_link_max_length" : "fill_link_max_length", flow.spacing());
-//            printf("flow spacing: %f,  is_external: %d, link_max_length: %lf\n", flow.spacing(), int(surface.is_external()), link_max_length);
+                    link_max_length = layerm.region().config().get_abs_value(surface.is_external() ? "external_fill_link_max_length" : "fill_link_max_length", flow.spacing());
+        //            printf("flow spacing: %f,  is_external: %d, link_max_length: %lf\n", flow.spacing(), int(surface.is_external()), link_max_length);
 #else
-            if (surface_fill.params.density > .8) // 80%
-                link_max_length = 3. * f->get_spacing();
+                    if (surface_fill.params.density > .8) // 80%
+                        link_max_length = 3. * f->get_spacing();
 #endif
-        }
-
-        // Maximum length of the perimeter segment linking two infill lines.
-        f->link_max_length = (coord_t)scale_(link_max_length);
-
-        //give the overlap size to let the infill do his overlap
-        //add overlap if at least one perimeter
-        float perimeter_spacing = 0;
-        if(layerm->region().config().perimeters == 1)
-            perimeter_spacing = layerm->flow(frExternalPerimeter).spacing();
-        else if(layerm->region().config().only_one_perimeter_top)
-            //note: use the min of the two to avoid overextrusion if only one perimeter top
-            perimeter_spacing = std::min(layerm->flow(frPerimeter).spacing(), layerm->flow(frExternalPerimeter).spacing());
-        else //if(layerm->region().config().perimeters > 1)
-            perimeter_spacing = layerm->flow(frPerimeter).spacing();
-
-        // Used by the concentric infill pattern to clip the loops to create extrusion paths.
-        f->loop_clipping = scale_t(layerm->region().config().get_computed_value("seam_gap", surface_fill.params.extruder - 1) * surface_fill.params.flow.nozzle_diameter());
-
-        // apply half spacing using this flow's own spacing and generate infill
-        //FillParams params;
-        //params.density         = float(0.01 * surface_fill.params.density);
-        //params.dont_adjust     = false; //surface_fill.params.dont_adjust; // false
-        //params.anchor_length   = surface_fill.params.anchor_length;
-        //params.anchor_length_max = surface_fill.params.anchor_length_max;
-        //params.resolution        = resolution;
-        surface_fill.params.use_arachne = perimeter_generator == PerimeterGeneratorType::Arachne && surface_fill.params.pattern == ipConcentric;
-        //params.layer_height      = m_regions[surface_fill.region_id]->layer()->height;
-
-        //union with safety offset to avoid separation from the appends of different surface with same settings.
-        surface_fill.expolygons = union_safety_offset_ex(surface_fill.expolygons);
-
-        //store default values, before modification.
-        bool dont_adjust = surface_fill.params.dont_adjust;
-        float density = surface_fill.params.density;
-        for (ExPolygon &expoly : surface_fill.expolygons) {
-            //set overlap polygons
-            f->no_overlap_expolygons.clear();
-            if (surface_fill.params.config->perimeters > 0) {
-                f->overlap = surface_fill.params.config->infill_overlap.get_abs_value((perimeter_spacing + (f->get_spacing())) / 2);
-                if (f->overlap != 0) {
-                    f->no_overlap_expolygons = intersection_ex(layerm->fill_no_overlap_expolygons, ExPolygons() = { expoly });
-                } else {
-                    f->no_overlap_expolygons.push_back(expoly);
                 }
-            } else {
-                f->overlap = 0;
-                f->no_overlap_expolygons.push_back(expoly);
-            }
 
-            //set default param (that can be modified by bridge thing)
-            surface_fill.params.dont_adjust = dont_adjust;
-            surface_fill.params.bridge_offset = 0;
-            surface_fill.params.density = density;
-            surface_fill.params.layer_height = m_regions[surface_fill.region_id]->layer()->height;
-
-            //init the surface with the current polygon
-            if (!expoly.contour.empty()) {
-                surface_fill.surface.expolygon = std::move(expoly);
-
-                //adjust the bridge density
-                if (surface_fill.params.flow.bridge() && surface_fill.params.density > 0.99 /*&& layerm->region()->config().bridge_overlap.get_abs_value(1) != 1*/) {
-                    // bridge have their own spacing, don't try to align it with normal infill.
-                    surface_fill.params.max_sparse_infill_spacing = 0;
-                    ////varies the overlap to have the best coverage for the bridge
-                    //surface_fill.params.density *= float(layerm->region()->config().bridge_overlap.get_abs_value(1));
-                    double min_spacing = 0.999 * surface_fill.params.spacing / surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
-                    double max_spacing = 1.001 * surface_fill.params.spacing / surface_fill.params.config->bridge_overlap_min.get_abs_value(surface_fill.params.density);
-                    double factor = 1.00001;
-                    if (min_spacing < max_spacing * 1.01) {
-                        // create a bouding box of the rotated surface
-                        coord_t bounding_box_size_x = 0;
-                        coord_t bounding_box_min_x = 0;
-                        ExPolygons expolys;
-                        if (surface_fill.params.bridge_angle > 0 && !f->no_overlap_expolygons.empty()) {
-                            //take only the no-overlap area
-                            expolys = offset_ex(intersection_ex(ExPolygons{ ExPolygon{surface_fill.surface.expolygon.contour} }, f->no_overlap_expolygons), -scale_t(surface_fill.params.spacing) / 2 - 10);
+                // Maximum length of the perimeter segment linking two infill lines.
+                f->link_max_length = (coord_t)scale_(link_max_length);
+
+                //give the overlap size to let the infill do his overlap
+                //add overlap if at least one perimeter
+                float perimeter_spacing = 0;
+                if(layerm->region().config().perimeters == 1)
+                    perimeter_spacing = layerm->flow(frExternalPerimeter).spacing();
+                else if(layerm->region().config().only_one_perimeter_top)
+                    //note: use the min of the two to avoid overextrusion if only one perimeter top
+                    perimeter_spacing = std::min(layerm->flow(frPerimeter).spacing(), layerm->flow(frExternalPerimeter).spacing());
+                else //if(layerm->region().config().perimeters > 1)
+                    perimeter_spacing = layerm->flow(frPerimeter).spacing();
+
+                // Used by the concentric infill pattern to clip the loops to create extrusion paths.
+                f->loop_clipping = scale_t(layerm->region().config().get_computed_value("seam_gap", surface_fill.params.extruder - 1) * surface_fill.params.flow.nozzle_diameter());
+
+                // apply half spacing using this flow's own spacing and generate infill
+                //FillParams params;
+                //params.density         = float(0.01 * surface_fill.params.density);
+                //params.dont_adjust     = false; //surface_fill.params.dont_adjust; // false
+                //params.anchor_length   = surface_fill.params.anchor_length;
+                //params.anchor_length_max = surface_fill.params.anchor_length_max;
+                //params.resolution        = resolution;
+                surface_fill.params.use_arachne = perimeter_generator == PerimeterGeneratorType::Arachne && surface_fill.params.pattern == ipConcentric;
+                //params.layer_height      = m_regions[surface_fill.region_id]->layer()->height;
+
+                //union with safety offset to avoid separation from the appends of different surface with same settings.
+                surface_fill.expolygons = union_safety_offset_ex(surface_fill.expolygons);
+
+                //store default values, before modification.
+                bool dont_adjust = surface_fill.params.dont_adjust;
+                float density = surface_fill.params.density;
+                for (ExPolygon &expoly : surface_fill.expolygons) {
+                    //set overlap polygons
+                    f->no_overlap_expolygons.clear();
+                    if (surface_fill.params.config->perimeters > 0) {
+                        f->overlap = surface_fill.params.config->infill_overlap.get_abs_value((perimeter_spacing + (f->get_spacing())) / 2);
+                        if (f->overlap != 0) {
+                            f->no_overlap_expolygons = intersection_ex(layerm->fill_no_overlap_expolygons, ExPolygons() = { expoly });
                         } else {
-                            expolys = offset_ex(ExPolygon{surface_fill.surface.expolygon.contour}, -scale_t(surface_fill.params.spacing) / 2 - 10);
-                        }
-                        // if nothing after collapse, then go to next surface_fill.expolygon
-                        if (expolys.empty())
-                            continue;
-
-                        BoundingBox bb;
-                        bool first = true;
-                        for (ExPolygon& expoly : expolys) {
-                            expoly.holes.clear();
-                            expoly.rotate(PI / 2 + (surface_fill.params.bridge_angle < 0 ? surface_fill.params.angle : surface_fill.params.bridge_angle));
-                            if (first) {
-                                bb = expoly.contour.bounding_box();
-                                first = false;
-                            } else {
-                                bb.merge(expoly.contour.points);
-                            }
+                            f->no_overlap_expolygons.push_back(expoly);
                         }
-                        bounding_box_size_x = bb.size().x();
-                        bounding_box_min_x = bb.min.x();
+                    } else {
+                        f->overlap = 0;
+                        f->no_overlap_expolygons.push_back(expoly);
+                    }
 
-                        //compute the dist
-                        double new_spacing = unscaled(f->_adjust_solid_spacing(bounding_box_size_x, scale_t(min_spacing), 2));
-                        if (new_spacing <= max_spacing) {
-                            surface_fill.params.density = factor * surface_fill.params.spacing / new_spacing;
-                        } else {
-                            double new_spacing2 = unscaled(f->_adjust_solid_spacing(bounding_box_size_x, scale_t(min_spacing * 1.999 - new_spacing), 2));
-                            if (new_spacing2 < min_spacing) {
-                                if (min_spacing - new_spacing2 < new_spacing - max_spacing) {
-                                    surface_fill.params.density = surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
+                    //set default param (that can be modified by bridge thing)
+                    surface_fill.params.dont_adjust = dont_adjust;
+                    surface_fill.params.bridge_offset = 0;
+                    surface_fill.params.density = density;
+                    surface_fill.params.layer_height = m_regions[surface_fill.region_id]->layer()->height;
+
+                    //init the surface with the current polygon
+                    if (!expoly.contour.empty()) {
+                        surface_fill.surface.expolygon = std::move(expoly);
+
+                        //adjust the bridge density
+                        if (surface_fill.params.flow.bridge() && surface_fill.params.density > 0.99 /*&& layerm->region()->config().bridge_overlap.get_abs_value(1) != 1*/) {
+                            // bridge have their own spacing, don't try to align it with normal infill.
+                            surface_fill.params.max_sparse_infill_spacing = 0;
+                            ////varies the overlap to have the best coverage for the bridge
+                            //surface_fill.params.density *= float(layerm->region()->config().bridge_overlap.get_abs_value(1));
+                            double min_spacing = 0.999 * surface_fill.params.spacing / surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
+                            double max_spacing = 1.001 * surface_fill.params.spacing / surface_fill.params.config->bridge_overlap_min.get_abs_value(surface_fill.params.density);
+                            double factor = 1.00001;
+                            if (min_spacing < max_spacing * 1.01) {
+                                // create a bouding box of the rotated surface
+                                coord_t bounding_box_size_x = 0;
+                                coord_t bounding_box_min_x = 0;
+                                ExPolygons expolys;
+                                if (surface_fill.params.bridge_angle > 0 && !f->no_overlap_expolygons.empty()) {
+                                    //take only the no-overlap area
+                                    expolys = offset_ex(intersection_ex(ExPolygons{ ExPolygon{surface_fill.surface.expolygon.contour} }, f->no_overlap_expolygons), -scale_t(surface_fill.params.spacing) / 2 - 10);
+                                } else {
+                                    expolys = offset_ex(ExPolygon{surface_fill.surface.expolygon.contour}, -scale_t(surface_fill.params.spacing) / 2 - 10);
+                                }
+                                // if nothing after collapse, then go to next surface_fill.expolygon
+                                if (expolys.empty())
+                                    continue;
+
+                                BoundingBox bb;
+                                bool first = true;
+                                for (ExPolygon& expoly : expolys) {
+                                    expoly.holes.clear();
+                                    expoly.rotate(PI / 2 + (surface_fill.params.bridge_angle < 0 ? surface_fill.params.angle : surface_fill.params.bridge_angle));
+                                    if (first) {
+                                        bb = expoly.contour.bounding_box();
+                                        first = false;
+                                    } else {
+                                        bb.merge(expoly.contour.points);
+                                    }
+                                }
+                                bounding_box_size_x = bb.size().x();
+                                bounding_box_min_x = bb.min.x();
+
+                                //compute the dist
+                                double new_spacing = unscaled(f->_adjust_solid_spacing(bounding_box_size_x, scale_t(min_spacing), 2));
+                                if (new_spacing <= max_spacing) {
+                                    surface_fill.params.density = factor * surface_fill.params.spacing / new_spacing;
                                 } else {
-                                    surface_fill.params.density = surface_fill.params.config->bridge_overlap_min.get_abs_value(surface_fill.params.density);
+                                    double new_spacing2 = unscaled(f->_adjust_solid_spacing(bounding_box_size_x, scale_t(min_spacing * 1.999 - new_spacing), 2));
+                                    if (new_spacing2 < min_spacing) {
+                                        if (min_spacing - new_spacing2 < new_spacing - max_spacing) {
+                                            surface_fill.params.density = surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
+                                        } else {
+                                            surface_fill.params.density = surface_fill.params.config->bridge_overlap_min.get_abs_value(surface_fill.params.density);
+                                        }
+                                    } else {
+                                        //use the highest density
+                                        surface_fill.params.density = surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
+                                    }
                                 }
-                            } else {
-                                //use the highest density
-                                surface_fill.params.density = surface_fill.params.config->bridge_overlap.get_abs_value(surface_fill.params.density);
+                                Polygon poly = surface_fill.surface.expolygon.contour;
+                                poly.rotate(PI / 2 + (surface_fill.params.bridge_angle < 0 ? surface_fill.params.angle : surface_fill.params.bridge_angle));
+                                surface_fill.params.dont_adjust = true;
+                                surface_fill.params.bridge_offset = std::abs(poly.bounding_box().min.x() - bounding_box_min_x);
                             }
                         }
-                        Polygon poly = surface_fill.surface.expolygon.contour;
-                        poly.rotate(PI / 2 + (surface_fill.params.bridge_angle < 0 ? surface_fill.params.angle : surface_fill.params.bridge_angle));
-                        surface_fill.params.dont_adjust = true;
-                        surface_fill.params.bridge_offset = std::abs(poly.bounding_box().min.x() - bounding_box_min_x);
-                    }
-                }
 
-                //make fill
-                while ((size_t)surface_fill.params.priority >= fills_by_priority.size())
-                    fills_by_priority.push_back(new ExtrusionEntityCollection());
+                        //make fill
+                        output.filled = true;
 #if _DEBUG
-                const size_t idx_start = fills_by_priority[(size_t)surface_fill.params.priority]->entities().size();
+                        const size_t idx_start = output.fills.entities().size();
 #endif
-                f->fill_surface_extrusion(&surface_fill.surface, surface_fill.params, fills_by_priority[(size_t)surface_fill.params.priority]->set_entities());
+                        f->fill_surface_extrusion(&surface_fill.surface, surface_fill.params, output.fills.set_entities());
 #if _DEBUG
-                //check no over or underextrusion if fill_exactly
-                if(surface_fill.params.fill_exactly && surface_fill.params.density == 1) {
-                    ExtrusionVolume compute_volume;
-                    ExtrusionVolume compute_volume_no_gap_fill(false);
-                    const size_t idx_end = fills_by_priority[(size_t)surface_fill.params.priority]->entities().size();
-                    //check that it doesn't overextrude
-                    for(size_t idx = idx_start; idx < idx_end; ++idx){
-                        fills_by_priority[(size_t)surface_fill.params.priority]->entities()[idx]->visit(compute_volume);
-                        fills_by_priority[(size_t)surface_fill.params.priority]->entities()[idx]->visit(compute_volume_no_gap_fill);
+                        //check no over or underextrusion if fill_exactly
+                        if(surface_fill.params.fill_exactly && surface_fill.params.density == 1) {
+                            ExtrusionVolume compute_volume;
+                            ExtrusionVolume compute_volume_no_gap_fill(false);
+                            const size_t idx_end = output.fills.entities().size();
+                            //check that it doesn't overextrude
+                            for(size_t idx = idx_start; idx < idx_end; ++idx){
+                                output.fills.entities()[idx]->visit(compute_volume);
+                                output.fills.entities()[idx]->visit(compute_volume_no_gap_fill);
+                            }
+                            ExPolygons temp = f->no_overlap_expolygons.empty() ?
+                                                ExPolygons{surface_fill.surface.expolygon} :
+                                                intersection_ex(ExPolygons{surface_fill.surface.expolygon}, f->no_overlap_expolygons);
+                            double real_surface = 0;
+                            for(auto &t : temp) real_surface += t.area();
+                            assert(compute_volume.volume < unscaled(unscaled(surface_fill.surface.area())) * surface_fill.params.layer_height + EPSILON);
+                            double area = unscaled(unscaled(real_surface));
+                            assert(compute_volume.volume <= area * surface_fill.params.layer_height * 1.001 || f->debug_verify_flow_mult <= 0.8);
+                            if(compute_volume.volume > 0) //can fail for thin regions
+                                assert(compute_volume.volume >= area * surface_fill.params.layer_height * 0.999 || f->debug_verify_flow_mult >= 1.3 || f->debug_verify_flow_mult == 0 // sawtooth output more filament,as it's 3D (debug_verify_flow_mult==0)
+                                    || area < std::max(1.,surface_fill.params.config->solid_infill_below_area.value));
+                        }
+#endif
                     }
-                    ExPolygons temp = f->no_overlap_expolygons.empty() ?
-                                        ExPolygons{surface_fill.surface.expolygon} :
-                                        intersection_ex(ExPolygons{surface_fill.surface.expolygon}, f->no_overlap_expolygons);
-                    double real_surface = 0;
-                    for(auto &t : temp) real_surface += t.area();
-                    assert(compute_volume.volume < unscaled(unscaled(surface_fill.surface.area())) * surface_fill.params.layer_height + EPSILON);
-                    double area = unscaled(unscaled(real_surface));
-                    assert(compute_volume.volume <= area * surface_fill.params.layer_height * 1.001 || f->debug_verify_flow_mult <= 0.8);
-                    if(compute_volume.volume > 0) //can fail for thin regions
-                        assert(compute_volume.volume >= area * surface_fill.params.layer_height * 0.999 || f->debug_verify_flow_mult >= 1.3 || f->debug_verify_flow_mult == 0 // sawtooth output more filament,as it's 3D (debug_verify_flow_mult==0)
-                            || area < std::max(1.,surface_fill.params.config->solid_infill_below_area.value));
                 }
-#endif
             }
+        });
+
+    // Store the fills in the order of the groups.
+    //surface_fills is sorted by region_id
+    size_t current_region_id = -1;
+    for (size_t surface_fill_idx = 0; surface_fill_idx < surface_fills.size(); ++ surface_fill_idx) {
+        const SurfaceFill &surface_fill = surface_fills[surface_fill_idx];
+        // store the region fill when changing region. 
+        if (current_region_id != size_t(-1) && current_region_id != surface_fill.region_id) {
+            store_fill(current_region_id);
+        }
+        current_region_id = surface_fill.region_id;
+        if (surface_fill_outputs[surface_fill_idx].filled) {
+            while ((size_t)surface_fill.params.priority >= fills_by_priority.size())
+                fills_by_priority.push_back(new ExtrusionEntityCollection());
+            fills_by_priority[(size_t)surface_fill.params.priority]->append_move_from(surface_fill_outputs[surface_fill_idx].fills);
         }
     }
     if(current_region_id != size_t(-1))
@@ -16,9 +16,7 @@
 #include <algorithm>
 #include <numeric>
 
-// Boost pool: Don't use mutexes to synchronize memory allocation.
-#define BOOST_POOL_NO_MT
-#include <boost/pool/object_pool.hpp>
+#include <tbb/parallel_for.h>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point.hpp>
@@ -235,14 +233,18 @@ static constexpr std::array<std::array<int, 8>, 3> child_traversal_order {
     std::array<int, 8>{ 1, 5, 0, 4, 3, 7, 2, 6 },
 };
 
+// Cube of an octree. The cubes of an octree are stored in a single array, children are referenced by their index into the array.
 struct Cube
 {
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
     Vec3d center;
 #ifndef NDEBUG
     Vec3d center_octree;
 #endif // NDEBUG
-    std::array<Cube*, 8> children {}; // initialized to nullptrs
-    Cube(const Vec3d &center) : center(center) {}
+    // Indices of the children cubes in the order of child_centers, NONE for a missing child.
+    std::array<uint32_t, 8> children;
+    Cube(const Vec3d &center) : center(center) { children.fill(NONE); }
 };
 
 struct CubeProperties
@@ -256,17 +258,17 @@ struct CubeProperties
 
 struct Octree
 {
-    // Octree will allocate its Cubes from the pool. The pool only supports deletion of the complete pool,
-    // perfect for building up our octree.
-    boost::object_pool<Cube>    pool;
-    Cube*                       root_cube { nullptr };
+    // All cubes of the octree in depth first order, the root cube first. As the children are visited in the order
+    // of child_centers, the cubes of a single level are sorted by the Morton code of their centers
+    // and the cubes of a subtree are stored next to each other.
+    std::vector<Cube>           cubes;
     Vec3d                       origin;
     std::vector<CubeProperties> cubes_properties;
 
     Octree(const Vec3d &origin, const std::vector<CubeProperties> &cubes_properties)
-        : root_cube(pool.construct(origin)), origin(origin), cubes_properties(cubes_properties) {}
+        : origin(origin), cubes_properties(cubes_properties) { cubes.emplace_back(origin); }
 
-    void insert_triangle(const Vec3d &a, const Vec3d &b, const Vec3d &c, Cube *current_cube, const BoundingBoxf3 &current_bbox, int depth);
+    const Cube& root_cube() const { return cubes.front(); }
 };
 
 void OctreeDeleter::operator()(Octree *p) {
@@ -368,6 +370,7 @@ struct FillContext
     };
 
     FillContext(const Octree &octree, double z_position, int direction_idx) :
+        cubes(octree.cubes),
         cubes_properties(octree.cubes_properties),
         z_position(z_position),
         traversal_order(child_traversal_order[direction_idx]),
@@ -381,6 +384,7 @@ struct FillContext
     // Rotate the point, uses the same convention as Point::rotate().
     Vec2d rotate(const Vec2d& v) { return Vec2d(this->cos_a * v.x() - this->sin_a * v.y(), this->sin_a * v.x() + this->cos_a * v.y()); }
 
+    const std::vector<Cube>            &cubes;
     const std::vector<CubeProperties>  &cubes_properties;
     // Top of the current layer.
     const double                        z_position;
@@ -424,7 +428,7 @@ static bool verify_traversal_order(
     for (int i = 0; i < 8; ++i) {
         int j = context.traversal_order[i];
         Vec3d cntr = to_world * (cube->center_octree + (child_centers[j] * (context.cubes_properties[depth].edge_length / 4.)));
-        assert(!cube->children[j] || cube->children[j]->center.isApprox(cntr));
+        assert(cube->children[j] == Cube::NONE || context.cubes[cube->children[j]].center.isApprox(cntr));
         c[i] = cntr;
     }
     std::array<Vec3d, 10> dirs = {
@@ -495,9 +499,8 @@ static void generate_infill_lines_recursive(
     -- depth;
     size_t i = 0;
     for (const int child_idx : context.traversal_order) {
-        const Cube *child = cube->children[child_idx];
-        if (child != nullptr)
-            generate_infill_lines_recursive(context, child, address, depth);
+        if (const uint32_t child = cube->children[child_idx]; child != Cube::NONE)
+            generate_infill_lines_recursive(context, &context.cubes[child], address, depth);
         if (++ i == 4)
             // right child index
             ++ address;
@@ -1338,7 +1341,7 @@ void Filler::_fill_surface_single(
         // Generate the infill lines along the octree cells, merge touching lines of the same direction.
         size_t num_lines = 0;
         for (auto &context : contexts) {
-            generate_infill_lines_recursive(context, adapt_fill_octree->root_cube, 0, int(adapt_fill_octree->cubes_properties.size()) - 1);
+            generate_infill_lines_recursive(context, &adapt_fill_octree->root_cube(), 0, int(adapt_fill_octree->cubes_properties.size()) - 1);
             num_lines += context.output_lines.size() + context.temp_lines.size();
         }
 
@@ -1452,15 +1455,72 @@ static inline bool is_overhang_triangle(const Vec3d &a, const Vec3d &b, const Ve
     return n.dot(up) > 0.707 * n.norm();
 }
 
-static void transform_center(Cube *current_cube, const Eigen::Matrix3d &rot)
+// Calculate a slightly expanded bounding box of a child cube to cope with triangles touching a cube wall and other numeric errors.
+// We will rather densify the octree a bit more than necessary instead of missing a triangle.
+static inline BoundingBoxf3 child_bbox(const Vec3d &center, const BoundingBoxf3 &bbox, int child_idx)
 {
+    const Vec3d &child_center_dir = child_centers[child_idx];
+    BoundingBoxf3 out;
+    for (int k = 0; k < 3; ++ k) {
+        if (child_center_dir[k] == -1.) {
+            out.min[k] = bbox.min[k];
+            out.max[k] = center[k] + EPSILON;
+        } else {
+            out.min[k] = center[k] - EPSILON;
+            out.max[k] = bbox.max[k];
+        }
+    }
+    return out;
+}
+
+static void insert_triangle(
+    const Vec3d &a, const Vec3d &b, const Vec3d &c,
+    const std::vector<CubeProperties> &cubes_properties, std::vector<Cube> &cubes, uint32_t current_cube, const BoundingBoxf3 &current_bbox, int depth)
+{
+    assert(current_cube < cubes.size());
+    assert(depth > 0);
+
+    --depth;
+
+    // Squared radius of a sphere around the child cube.
+    // const double r2_cube = Slic3r::sqr(0.5 * cubes_properties[depth].height + EPSILON);
+
+    // Copy of the center, cubes may get reallocated when adding a child.
+    const Vec3d center = cubes[current_cube].center;
+    for (int i = 0; i < 8; ++ i) {
+        BoundingBoxf3 bbox = child_bbox(center, current_bbox, i);
+        //if (dist2_to_triangle(a, b, c, child_center) < r2_cube) {
+        // dist2_to_triangle and r2_cube are commented out too.
+        if (triangle_AABB_intersects(a, b, c, bbox)) {
+            uint32_t child = cubes[current_cube].children[i];
+            if (child == Cube::NONE) {
+                assert(cubes.size() < Cube::NONE);
+                child = uint32_t(cubes.size());
+                cubes.emplace_back(center + (child_centers[i] * (cubes_properties[depth].edge_length / 2.)));
+                cubes[current_cube].children[i] = child;
+            }
+            if (depth > 0)
+                insert_triangle(a, b, c, cubes_properties, cubes, child, bbox, depth);
+        }
+    }
+}
+
+// Append the subtree of src starting with src_cube to dst in depth first order, rotate the cube centers with rot.
+// Returns index of src_cube in dst.
+static uint32_t append_depth_first(std::vector<Cube> &dst, const std::vector<Cube> &src, uint32_t src_cube, const Eigen::Matrix3d &rot)
+{
+    const Cube     &cube = src[src_cube];
+    const uint32_t  idx  = uint32_t(dst.size());
+    dst.emplace_back(rot * cube.center);
 #ifndef NDEBUG
-    current_cube->center_octree = current_cube->center;
+    dst.back().center_octree = cube.center;
 #endif // NDEBUG
-    current_cube->center = rot * current_cube->center;
-    for (auto *child : current_cube->children)
-        if (child)
-            transform_center(child, rot);
+    for (int i = 0; i < 8; ++ i)
+        if (cube.children[i] != Cube::NONE) {
+            const uint32_t child = append_depth_first(dst, src, cube.children[i], rot);
+            dst[idx].children[i] = child;
+        }
+    return idx;
 }
 
 OctreePtr build_octree(
@@ -1481,72 +1541,80 @@ OctreePtr build_octree(
     auto                        octree           = OctreePtr(new Octree(cube_center, cubes_properties));
 
     if (cubes_properties.size() > 1) {
-        Octree *octree_ptr = octree.get();
         double edge_length_half = 0.5 * cubes_properties.back().edge_length;
         Vec3d  diag_half(edge_length_half, edge_length_half, edge_length_half);
         int    max_depth = int(cubes_properties.size()) - 1;
-        auto process_triangle = [octree_ptr, max_depth, diag_half](const Vec3d &a, const Vec3d &b, const Vec3d &c) {
-            octree_ptr->insert_triangle(
-                a, b, c,
-                octree_ptr->root_cube,
-                BoundingBoxf3(octree_ptr->root_cube->center - diag_half, octree_ptr->root_cube->center + diag_half),
-                max_depth);
+        const BoundingBoxf3 root_bbox(cube_center - diag_half, cube_center + diag_half);
+        // Mesh triangles first, then the overhang triangles.
+        const size_t num_mesh_triangles = triangle_mesh.indices.size();
+        const size_t num_triangles      = num_mesh_triangles + overhang_triangles.size() / 3;
+        auto triangle = [&triangle_mesh, &overhang_triangles, num_mesh_triangles](size_t idx) -> std::array<Vec3d, 3> {
+            if (idx < num_mesh_triangles) {
+                const stl_triangle_vertex_indices &tri = triangle_mesh.indices[idx];
+                return { triangle_mesh.vertices[tri[0]].cast<double>(), triangle_mesh.vertices[tri[1]].cast<double>(), triangle_mesh.vertices[tri[2]].cast<double>() };
+            }
+            idx = (idx - num_mesh_triangles) * 3;
+            return { overhang_triangles[idx], overhang_triangles[idx + 1], overhang_triangles[idx + 2] };
         };
-        auto up_vector = support_overhangs_only ? Vec3d(transform_to_octree() * Vec3d(0., 0., 1.)) : Vec3d();
-        for (auto &tri : triangle_mesh.indices) {
-            auto a = triangle_mesh.vertices[tri[0]].cast<double>();
-            auto b = triangle_mesh.vertices[tri[1]].cast<double>();
-            auto c = triangle_mesh.vertices[tri[2]].cast<double>();
-            if (! support_overhangs_only || is_overhang_triangle(a, b, c, up_vector))
-                process_triangle(a, b, c);
-        }
-        for (size_t i = 0; i < overhang_triangles.size(); i += 3)
-            process_triangle(overhang_triangles[i], overhang_triangles[i + 1], overhang_triangles[i + 2]);
-        {
-            // Transform the octree to world coordinates to reduce computation when extracting infill lines.
-            auto rot = transform_to_world().toRotationMatrix();
-            transform_center(octree->root_cube, rot);
-            octree->origin = rot * octree->origin;
-        }
-    }
 
-    return octree;
-}
-
-void Octree::insert_triangle(const Vec3d &a, const Vec3d &b, const Vec3d &c, Cube *current_cube, const BoundingBoxf3 &current_bbox, int depth)
-{
-    assert(current_cube);
-    assert(depth > 0);
+        // Split the root cube into its 8 children, find the children intersected by each triangle.
+        std::vector<uint8_t> triangle_children(num_triangles, 0);
+        auto up_vector = support_overhangs_only ? Vec3d(transform_to_octree() * Vec3d(0., 0., 1.)) : Vec3d();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_triangles), 
+            [&triangle, &triangle_children, &root_bbox, &cube_center, &up_vector, num_mesh_triangles, support_overhangs_only](const tbb::blocked_range<size_t> &range) {
+            for (size_t idx = range.begin(); idx < range.end(); ++ idx) {
+                const auto [a, b, c] = triangle(idx);
+                if (support_overhangs_only && idx < num_mesh_triangles && ! is_overhang_triangle(a, b, c, up_vector))
+                    continue;
+                uint8_t mask = 0;
+                for (int i = 0; i < 8; ++ i)
+                    if (triangle_AABB_intersects(a, b, c, child_bbox(cube_center, root_bbox, i)))
+                        mask |= uint8_t(1 << i);
+                triangle_children[idx] = mask;
+            }
+        });
 
-    --depth;
+        // Build the 8 subtrees of the root cube in parallel. The subtree cubes are indexed locally,
+        // the first cube of a non-empty subtree is the child of the root.
+        std::array<std::vector<Cube>, 8> subtrees;
+        tbb::parallel_for(tbb::blocked_range<int>(0, 8, 1), 
+            [&triangle, &triangle_children, &cubes_properties, &subtrees, &root_bbox, &cube_center, max_depth, num_triangles](const tbb::blocked_range<int> &range) {
+            for (int i = range.begin(); i < range.end(); ++ i) {
+                const uint8_t        child_mask = uint8_t(1 << i);
+                const BoundingBoxf3  bbox       = child_bbox(cube_center, root_bbox, i);
+                std::vector<Cube>   &cubes      = subtrees[i];
+                for (size_t idx = 0; idx < num_triangles; ++ idx)
+                    if (triangle_children[idx] & child_mask) {
+                        if (cubes.empty())
+                            cubes.emplace_back(cube_center + (child_centers[i] * (cubes_properties[max_depth - 1].edge_length / 2.)));
+                        if (max_depth > 1) {
+                            const auto [a, b, c] = triangle(idx);
+                            insert_triangle(a, b, c, cubes_properties, cubes, 0, bbox, max_depth - 1);
+                        }
+                    }
+            }
+        });
 
-    // Squared radius of a sphere around the child cube.
-    // const double r2_cube = Slic3r::sqr(0.5 * this->cubes_properties[depth].height + EPSILON);
-
-    for (size_t i = 0; i < 8; ++ i) {
-        const Vec3d &child_center_dir = child_centers[i];
-        // Calculate a slightly expanded bounding box of a child cube to cope with triangles touching a cube wall and other numeric errors.
-        // We will rather densify the octree a bit more than necessary instead of missing a triangle.
-        BoundingBoxf3 bbox;
-        for (int k = 0; k < 3; ++ k) {
-            if (child_center_dir[k] == -1.) {
-                bbox.min[k] = current_bbox.min[k];
-                bbox.max[k] = current_cube->center[k] + EPSILON;
-            } else {
-                bbox.min[k] = current_cube->center[k] - EPSILON;
-                bbox.max[k] = current_bbox.max[k];
+        // Merge the subtrees into a single depth first ordered array.
+        // Transform the octree to world coordinates to reduce computation when extracting infill lines.
+        auto rot = transform_to_world().toRotationMatrix();
+        octree->cubes.clear();
+        octree->cubes.reserve(1 + std::accumulate(subtrees.begin(), subtrees.end(), size_t(0), [](size_t n, const std::vector<Cube> &cubes) { return n + cubes.size(); }));
+        octree->cubes.emplace_back(rot * cube_center);
+#ifndef NDEBUG
+        octree->cubes.front().center_octree = cube_center;
+#endif // NDEBUG
+        for (int i = 0; i < 8; ++ i)
+            if (! subtrees[i].empty()) {
+                const uint32_t child = append_depth_first(octree->cubes, subtrees[i], 0, rot);
+                octree->cubes.front().children[i] = child;
+                // Release the memory early.
+                subtrees[i] = std::vector<Cube>();
             }
-        }
-        Vec3d child_center = current_cube->center + (child_center_dir * (this->cubes_properties[depth].edge_length / 2.));
-        //if (dist2_to_triangle(a, b, c, child_center) < r2_cube) {
-        // dist2_to_triangle and r2_cube are commented out too.
-        if (triangle_AABB_intersects(a, b, c, bbox)) {
-            if (! current_cube->children[i])
-                current_cube->children[i] = this->pool.construct(child_center);
-            if (depth > 0)
-                this->insert_triangle(a, b, c, current_cube->children[i], bbox, depth);
-        }
+        octree->origin = rot * octree->origin;
     }
+
+    return octree;
 }
 
 } // namespace FillAdaptive
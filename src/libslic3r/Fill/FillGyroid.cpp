@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <iostream>
 
+#include <tbb/parallel_for.h>
+
 #include "FillGyroid.hpp"
 
 namespace Slic3r {
@@ -36,7 +38,7 @@ static inline Polyline make_wave(
     double period = points.back()(0);
     if (width != period) // do not extend if already truncated
     {
-        points.reserve(one_period.size() * size_t(floor(width / period)));
+        points.reserve(one_period.size() * size_t(ceil(width / period)) + 1);
         points.pop_back();
 
         size_t n = points.size();
@@ -61,7 +63,7 @@ static inline Polyline make_wave(
     return polyline;
 }
 
-static std::vector<Vec2d> make_one_period(double width, double scaleFactor, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
+static std::vector<Vec2d> make_one_period(double width, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
 {
     std::vector<Vec2d> points;
     double dx = M_PI_2; // exact coordinates on main inflexion lobes
@@ -101,7 +103,7 @@ static std::vector<Vec2d> make_one_period(double width, double scaleFactor, doub
     return points;
 }
 
-static Polylines make_gyroid_waves(coordf_t gridZ, coordf_t scaleFactor, double width, double height, double tolerance)
+Polylines make_gyroid_waves(coordf_t gridZ, coordf_t scaleFactor, double width, double height, double tolerance, GyroidPeriods &periods)
 {
 
     //scale factor for 5% : 8 712 388
@@ -113,29 +115,42 @@ static Polylines make_gyroid_waves(coordf_t gridZ, coordf_t scaleFactor, double
     bool vertical = (std::abs(z_sin) <= std::abs(z_cos));
     double lower_bound = 0.;
     double upper_bound = height;
-    bool flip = true;
     if (vertical) {
-        flip = false;
         lower_bound = -M_PI;
         upper_bound = width - M_PI_2;
         std::swap(width,height);
     }
 
-    std::vector<Vec2d> one_period_odd = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip, tolerance); // creates one period of the waves, so it doesn't have to be recalculated all the time
-    flip = !flip;                                                                   // even polylines are a bit shifted
-    std::vector<Vec2d> one_period_even = make_one_period(width, scaleFactor, z_cos, z_sin, vertical, flip, tolerance);
-    Polylines result;
+    // one period of the waves, so it doesn't have to be recalculated all the time
+    // make_one_period() only depends on the width up to one period.
+    if (const double limit = std::min(2 * M_PI, width); periods.z != z || periods.tolerance != tolerance || periods.limit != limit) {
+        const bool flip = ! vertical;
+        periods.z         = z;
+        periods.tolerance = tolerance;
+        periods.limit     = limit;
+        periods.odd       = make_one_period(width, z_cos, z_sin, vertical, flip, tolerance);
+        // even polylines are a bit shifted
+        periods.even      = make_one_period(width, z_cos, z_sin, vertical, ! flip, tolerance);
+    }
+    // the last point of both the odd and the even polylines is evaluated with the flip of the even ones
+    const bool flip = vertical;
 
+    // offsets of the odd and even polylines, accumulated as they always were to get the very same waves
+    std::vector<double> offsets;
     for (double y0 = lower_bound; y0 < upper_bound + EPSILON; y0 += M_PI) {
-        // creates odd polylines
-        result.emplace_back(make_wave(one_period_odd, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
-        // creates even polylines
+        offsets.emplace_back(y0);
         y0 += M_PI;
-        if (y0 < upper_bound + EPSILON) {
-            result.emplace_back(make_wave(one_period_even, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
-        }
+        if (y0 < upper_bound + EPSILON)
+            offsets.emplace_back(y0);
     }
 
+    Polylines result(offsets.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, offsets.size(), 16),
+        [&result, &offsets, &periods, width, height, scaleFactor, z_cos, z_sin, vertical, flip](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                result[i] = make_wave((i & 1) ? periods.even : periods.odd, width, height, offsets[i], scaleFactor, z_cos, z_sin, vertical, flip);
+        });
+
     return result;
 }
 
@@ -169,7 +184,8 @@ void FillGyroid::_fill_surface_single(
         coordf_t(line_spacing),
         ceil(bb.size()(0) / line_spacing) + 1.,
         ceil(bb.size()(1) / line_spacing) + 1.,
-        tolerance);
+        tolerance,
+        m_periods);
 
     // shift the polyline to the grid origin
     for (Polyline &pl : polylines)
@@ -4,10 +4,29 @@
 #include "../libslic3r.h"
 #include "../Geometry.hpp"
 
+#include <limits>
+
 #include "FillBase.hpp"
 
 namespace Slic3r {
 
+// One period of the odd and of the even waves of the gyroid. It depends on the z of the layer and on the tolerance,
+// not on the bounding box of the surface unless the surface is narrower than a period.
+struct GyroidPeriods
+{
+    // z of the waves, NaN if not computed yet.
+    double              z         { std::numeric_limits<double>::quiet_NaN() };
+    double              tolerance { 0. };
+    // Length of the period, shorter than 2 PI for a narrow surface.
+    double              limit     { 0. };
+    std::vector<Vec2d>  odd;
+    std::vector<Vec2d>  even;
+};
+
+// Waves of the gyroid pattern at gridZ covering width x height, all in units of scaleFactor.
+// The periods are reused if they were computed for the same z, tolerance and width, and recomputed otherwise.
+Polylines make_gyroid_waves(coordf_t gridZ, coordf_t scaleFactor, double width, double height, double tolerance, GyroidPeriods &periods);
+
 class FillGyroid : public Fill
 {
 public:
@@ -29,6 +48,11 @@ protected:
         const std::pair<float, Point>   &direction, 
         ExPolygon                        expolygon, 
         Polylines                       &polylines_out) const override;
+
+private:
+    // Periods of the waves of the last filled surface, reused by the following surfaces filled at the same z,
+    // usually the other islands of the same layer. A filler is only used by one thread at a time.
+    mutable GyroidPeriods m_periods;
 };
 
 } // namespace Slic3r
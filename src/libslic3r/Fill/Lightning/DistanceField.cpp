@@ -122,6 +122,10 @@ void DistanceField::update(const Point& to_node, const Point& added_leaf)
     Point grid_loc;
     for (grid_addr.y() = grid.min.y(); grid_addr.y() <= grid.max.y(); ++grid_addr.y()) {
         for (grid_addr.x() = grid.min.x(); grid_addr.x() <= grid.max.x(); ++grid_addr.x()) {
+            // Most of the grid cells have no unsupported point left, look it up before testing the cell against the branch.
+            const size_t cell_idx = m_unsupported_points_grid.find_cell_idx(grid_addr);
+            if (cell_idx == std::numeric_limits<size_t>::max())
+                continue;
             grid_loc = this->from_grid_point(grid_addr);
             // Test inside a circle at the new leaf.
             if ((grid_loc - added_leaf).cast<int64_t>().squaredNorm() > m_supporting_radius2) {
@@ -138,12 +142,9 @@ void DistanceField::update(const Point& to_node, const Point& added_leaf)
             }
             // Inside a circle at the end of the new leaf, or inside a rotated rectangle.
             // Remove unsupported leafs at this grid location.
-            if (const size_t cell_idx = m_unsupported_points_grid.find_cell_idx(grid_addr); cell_idx != std::numeric_limits<size_t>::max()) {
-                const UnsupportedCell &cell = m_unsupported_points[cell_idx];
-                if ((cell.loc - added_leaf).cast<int64_t>().squaredNorm() <= m_supporting_radius2) {
-                    m_unsupported_points_erased[cell_idx] = true;
-                    m_unsupported_points_grid.mark_erased(grid_addr);
-                }
+            if (const UnsupportedCell &cell = m_unsupported_points[cell_idx]; (cell.loc - added_leaf).cast<int64_t>().squaredNorm() <= m_supporting_radius2) {
+                m_unsupported_points_erased[cell_idx] = true;
+                m_unsupported_points_grid.mark_erased(grid_addr);
             }
         }
     }
@@ -124,14 +124,13 @@ protected:
             m_grid_range  = BoundingBox(map_cell_to_grid(unsupported_points_bbox.min), map_cell_to_grid(unsupported_points_bbox.max));
             m_grid_size   = m_grid_range.size() + Point::Ones();
 
-            m_data.assign(m_grid_size.y() * m_grid_size.x(), std::numeric_limits<size_t>::max());
-            m_data_erased.assign(m_grid_size.y() * m_grid_size.x(), true);
+            assert(unsupported_points.size() < NONE);
+            m_data.assign(m_grid_size.y() * m_grid_size.x(), NONE);
 
             for (size_t cell_idx = 0; cell_idx < unsupported_points.size(); ++cell_idx) {
                 const size_t flat_idx   = map_to_flat_array(map_cell_to_grid(unsupported_points[cell_idx].loc));
-                assert(m_data[flat_idx] == std::numeric_limits<size_t>::max());
-                m_data[flat_idx]        = cell_idx;
-                m_data_erased[flat_idx] = false;
+                assert(m_data[flat_idx] == NONE);
+                m_data[flat_idx]        = uint32_t(cell_idx);
             }
         }
 
@@ -142,10 +141,8 @@ protected:
             if (!m_grid_range.contains(grid_addr))
                 return std::numeric_limits<size_t>::max();
 
-            if (const size_t flat_idx = map_to_flat_array(grid_addr); !m_data_erased[flat_idx]) {
-                assert(m_data[flat_idx] != std::numeric_limits<size_t>::max());
-                return m_data[flat_idx];
-            }
+            if (const uint32_t cell_idx = m_data[map_to_flat_array(grid_addr)]; cell_idx != NONE)
+                return cell_idx;
 
             return std::numeric_limits<size_t>::max();
         }
@@ -157,21 +154,24 @@ protected:
                 return;
 
             const size_t flat_idx = map_to_flat_array(grid_addr);
-            assert(!m_data_erased[flat_idx] && m_data[flat_idx] != std::numeric_limits<size_t>::max());
+            assert(m_data[flat_idx] != NONE);
             assert(m_size != 0);
 
-            m_data_erased[flat_idx] = true;
+            m_data[flat_idx] = NONE;
             --m_size;
         }
 
     private:
+        // Marks a grid cell without an unsupported point, or with an erased one.
+        static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
         size_t m_size = 0;
 
         BoundingBox m_grid_range;
         Point       m_grid_size;
 
-        std::vector<size_t> m_data;
-        std::vector<bool>   m_data_erased;
+        // Index of the unsupported point of each grid cell, row by row. 32 bit to keep more of the grid in the cache.
+        std::vector<uint32_t> m_data;
 
         inline size_t map_to_flat_array(const Point &loc) const
         {
@@ -8,6 +8,8 @@
 #include "../../Layer.hpp"
 #include "../../Print.hpp"
 
+#include <tbb/parallel_for.h>
+
 /* Possible future tasks/optimizations,etc.:
  * - Improve connecting heuristic to favor connecting to shorter trees
  * - Change which node of a tree is the root when that would be better in reconnectRoots.
@@ -48,33 +50,47 @@ Generator::Generator(const PrintObject &print_object, const coordf_t fill_densit
     m_prune_length                                    = coord_t(layer_thickness * std::tan(lightning_infill_prune_angle));
     m_straightening_max_distance                      = coord_t(layer_thickness * std::tan(lightning_infill_straightening_angle));
 
+    generateInfillOutlines(print_object, throw_on_cancel_callback);
     generateInitialInternalOverhangs(print_object, throw_on_cancel_callback);
     generateTrees(print_object, throw_on_cancel_callback);
 }
 
-void Generator::generateInitialInternalOverhangs(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
+void Generator::generateInfillOutlines(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
 {
-    m_overhang_per_layer.resize(print_object.layers().size());
+    m_infill_outlines.assign(print_object.layers().size(), Polygons());
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, print_object.layers().size()),
+        [this, &print_object, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+                throw_on_cancel_callback();
+                Polygons infill_area;
+                for (const LayerRegion *layerm : print_object.get_layer(int(layer_id))->regions())
+                    for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                        if (surface.surface_type == (stPosInternal | stDensSparse) || surface.surface_type == (stPosInternal | stDensVoid))
+                            append(infill_area, to_polygons(surface.expolygon));
+                m_infill_outlines[layer_id] = union_(infill_area);
+            }
+        });
+}
 
-    Polygons infill_area_above;
-    //Iterate from top to bottom, to subtract the overhang areas above from the overhang areas on the layer below, to get only overhang in the top layer where it is overhanging.
-    for (int layer_nr = int(print_object.layers().size()) - 1; layer_nr >= 0; --layer_nr) {
-        throw_on_cancel_callback();
-        Polygons infill_area_here;
-        for (const LayerRegion* layerm : print_object.get_layer(layer_nr)->regions())
-            for (const Surface& surface : layerm->fill_surfaces.surfaces)
-                if (surface.surface_type == (stPosInternal | stDensSparse) || surface.surface_type == (stPosInternal | stDensVoid))
-                    append(infill_area_here, to_polygons(surface.expolygon));
-
-        infill_area_here = union_(infill_area_here);
-        //Remove the part of the infill area that is already supported by the walls.
-        Polygons overhang = diff(offset(infill_area_here, -float(m_wall_supporting_radius)), infill_area_above);
-        // Filter out unprintable polygons and near degenerated polygons (three almost collinear points and so).
-        overhang = opening(overhang, float(SCALED_EPSILON), float(SCALED_EPSILON));
-
-        m_overhang_per_layer[layer_nr] = overhang;
-        infill_area_above = std::move(infill_area_here);
-    }
+void Generator::generateInitialInternalOverhangs(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
+{
+    m_overhang_per_layer.assign(print_object.layers().size(), Polygons());
+
+    // Subtract the infill area above from the overhang areas on the layer below, to get only overhang in the top layer where it is overhanging.
+    // The layers only depend on the infill areas, so they are processed in parallel.
+    const Polygons no_infill_area;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, print_object.layers().size()),
+        [this, &no_infill_area, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_nr = range.begin(); layer_nr < range.end(); ++ layer_nr) {
+                throw_on_cancel_callback();
+                //Remove the part of the infill area that is already supported by the walls.
+                const Polygons &infill_area_above = layer_nr + 1 < m_infill_outlines.size() ? m_infill_outlines[layer_nr + 1] : no_infill_area;
+                Polygons overhang = diff(offset(m_infill_outlines[layer_nr], -float(m_wall_supporting_radius)), infill_area_above);
+                // Filter out unprintable polygons and near degenerated polygons (three almost collinear points and so).
+                m_overhang_per_layer[layer_nr] = opening(overhang, float(SCALED_EPSILON), float(SCALED_EPSILON));
+            }
+        });
 }
 
 const Layer& Generator::getTreesForLayer(const size_t& layer_id) const
@@ -87,18 +103,7 @@ void Generator::generateTrees(const PrintObject &print_object, const std::functi
 {
     m_lightning_layers.resize(print_object.layers().size());
 
-    std::vector<Polygons> infill_outlines(print_object.layers().size(), Polygons());
-
-    // For-each layer from top to bottom:
-    for (int layer_id = int(print_object.layers().size()) - 1; layer_id >= 0; layer_id--) {
-        throw_on_cancel_callback();
-        for (const LayerRegion *layerm : print_object.get_layer(layer_id)->regions())
-            for (const Surface &surface : layerm->fill_surfaces.surfaces)
-                if (surface.surface_type == (stPosInternal | stDensSparse) || surface.surface_type == (stPosInternal | stDensVoid))
-                    append(infill_outlines[layer_id], to_polygons(surface.expolygon));
-
-        infill_outlines[layer_id] = union_(infill_outlines[layer_id]);
-    }
+    const std::vector<Polygons> &infill_outlines = m_infill_outlines;
 
     // For various operations its beneficial to quickly locate nearby features on the polygon:
     const size_t top_layer_id = print_object.layers().size() - 1;
@@ -120,7 +125,7 @@ void Generator::generateTrees(const PrintObject &print_object, const std::functi
 
         // Initialize trees for next lower layer from the current one.
         if (layer_id == 0)
-            return;
+            break;
 
         const Polygons& below_outlines = infill_outlines[layer_id - 1];
         BoundingBox     below_outlines_bbox = get_extents(below_outlines).inflated(SCALED_EPSILON);
@@ -137,6 +142,10 @@ void Generator::generateTrees(const PrintObject &print_object, const std::functi
         for (auto& tree : current_lightning_layer.tree_roots)
             tree->propagateToNextLayer(lower_trees, below_outlines, outlines_locator, m_prune_length, m_straightening_max_distance, locator_cell_size / 2);
     }
+
+    // Only needed to generate the trees.
+    m_infill_outlines.clear();
+    m_infill_outlines.shrink_to_fit();
 }
 
 } // namespace Slic3r::FillLightning
@@ -60,6 +60,11 @@ public:
     float infilll_extrusion_width() const { return m_infill_extrusion_width; }
 
 protected:
+    /*!
+     * Collect the sparse infill areas of all layers.
+     */
+    void generateInfillOutlines(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback);
+
     /*!
      * Calculate the overhangs above the infill areas that need to be supported
      * by infill.
@@ -117,6 +122,14 @@ protected:
      */
     std::vector<Polygons> m_overhang_per_layer;
 
+    /*!
+     * For each layer, the union of its sparse infill areas.
+     *
+     * This is generated by \ref generateInfillOutlines and released by
+     * \ref generateTrees.
+     */
+    std::vector<Polygons> m_infill_outlines;
+
     /*!
      * For each layer, the generated lightning paths.
      *
@@ -37,6 +37,10 @@ namespace pt = boost::property_tree;
 
 #include <fast_float/fast_float.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include "bbs_3mf.hpp"
 
 // Slightly faster than sprintf("%.9g"), but there is an issue with the karma floating point formatter,
@@ -572,7 +576,11 @@ namespace Slic3r {
         bool _handle_start_config_metadata(const char** attributes, unsigned int num_attributes);
         bool _handle_end_config_metadata();
 
+        // Splits the meshes of the volumes out of the imported geometry.
+        // Neither the importer nor the object are modified, thus it may be called for multiple objects in parallel.
+        bool _build_volume_meshes(const ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, std::vector<TriangleMesh>& meshes, std::string& error) const;
         bool _generate_volumes(ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, ConfigSubstitutionContext& config_substitutions, DynamicPrintConfig& global_config);
+        bool _generate_volumes(ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, std::vector<TriangleMesh>&& meshes, ConfigSubstitutionContext& config_substitutions, DynamicPrintConfig& global_config);
 
         // callbacks to parse the .model file
         static void XMLCALL _handle_start_model_xml_element(void* userData, const char* name, const char** attributes);
@@ -875,6 +883,20 @@ namespace Slic3r {
             }
         }
 
+        // Volumes to be generated for each object. The meshes of all the objects are split out of the imported geometries
+        // and their statistics are computed in parallel, then the volumes are added to the objects serially.
+        struct ObjectVolumes
+        {
+            ModelObject*                        model_object { nullptr };
+            const Geometry*                     geometry { nullptr };
+            ObjectMetadata::VolumeMetadataList  volumes;
+            ObjectMetadata::VolumeMetadataList* volumes_ptr { nullptr };
+            std::vector<TriangleMesh>           meshes;
+            std::string                         error;
+        };
+        std::vector<ObjectVolumes> objects_volumes(m_objects.size());
+
+        size_t object_volumes_idx = 0;
         for (const IdToModelObjectMap::value_type& object : m_objects) {
             if (object.second >= int(m_model->objects.size())) {
                 add_error("Unable to find object");
@@ -909,8 +931,11 @@ namespace Slic3r {
                 model_object->sla_drain_holes = std::move(obj_drain_holes->second);
             }
 
-            ObjectMetadata::VolumeMetadataList  volumes;
-            ObjectMetadata::VolumeMetadataList* volumes_ptr = nullptr;
+            ObjectVolumes &object_volumes = objects_volumes[object_volumes_idx ++];
+            object_volumes.model_object = model_object;
+            object_volumes.geometry     = &obj_geometry->second;
+            ObjectMetadata::VolumeMetadataList  &volumes     = object_volumes.volumes;
+            ObjectMetadata::VolumeMetadataList* &volumes_ptr = object_volumes.volumes_ptr;
 
             IdToMetadataMap::iterator obj_metadata = m_objects_metadata.find(object.first);
             if (obj_metadata != m_objects_metadata.end()) {
@@ -940,7 +965,26 @@ namespace Slic3r {
                 volumes_ptr = &volumes;
             }
 
-            if (!_generate_volumes(*model_object, obj_geometry->second, *volumes_ptr, config_substitutions, config))
+        }
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, objects_volumes.size(), 1),
+            [this, &objects_volumes](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++ i) {
+                    ObjectVolumes &object_volumes = objects_volumes[i];
+                    if (! _build_volume_meshes(*object_volumes.model_object, *object_volumes.geometry, *object_volumes.volumes_ptr, object_volumes.meshes, object_volumes.error))
+                        // release the meshes built so far, the import is going to fail anyway
+                        object_volumes.meshes.clear();
+                }
+            });
+
+        for (ObjectVolumes &object_volumes : objects_volumes) {
+            if (!object_volumes.error.empty()) {
+                add_error(object_volumes.error);
+                return false;
+            }
+
+            ModelObject* model_object = object_volumes.model_object;
+            if (!_generate_volumes(*model_object, *object_volumes.geometry, *object_volumes.volumes_ptr, std::move(object_volumes.meshes), config_substitutions, config))
                 return false;
 
             if (use_prusa_config) {
@@ -1736,10 +1780,19 @@ namespace Slic3r {
     {
         // appends the vertex coordinates
         // missing values are set equal to ZERO
-        m_curr_object.geometry.vertices.emplace_back(
-            m_unit_factor * get_attribute_value_float(attributes, num_attributes, X_ATTR),
-            m_unit_factor * get_attribute_value_float(attributes, num_attributes, Y_ATTR),
-            m_unit_factor * get_attribute_value_float(attributes, num_attributes, Z_ATTR));
+        // The vertices are the bulk of the model file, thus the attributes are parsed in a single pass
+        // instead of looking up each of them with get_attribute_value_float().
+        Vec3f vertex = Vec3f::Zero();
+        if (attributes != nullptr && num_attributes % 2 == 0) {
+            for (unsigned int a = 0; a < num_attributes; a += 2) {
+                const char *key = attributes[a];
+                if (key[0] >= 'x' && key[0] <= 'z' && key[1] == 0) {
+                    const char *text = attributes[a + 1];
+                    fast_float::from_chars(text, text + strlen(text), vertex[key[0] - 'x']);
+                }
+            }
+        }
+        m_curr_object.geometry.vertices.emplace_back(m_unit_factor * vertex);
         return true;
     }
 
@@ -1773,14 +1826,30 @@ namespace Slic3r {
 
         // appends the triangle's vertices indices
         // missing values are set equal to ZERO
-        m_curr_object.geometry.triangles.emplace_back(
-            get_attribute_value_int(attributes, num_attributes, V1_ATTR),
-            get_attribute_value_int(attributes, num_attributes, V2_ATTR),
-            get_attribute_value_int(attributes, num_attributes, V3_ATTR));
-
-        m_curr_object.geometry.custom_supports.push_back(get_attribute_value_string(attributes, num_attributes, CUSTOM_SUPPORTS_ATTR));
-        m_curr_object.geometry.custom_seam.push_back(get_attribute_value_string(attributes, num_attributes, CUSTOM_SEAM_ATTR));
-        m_curr_object.geometry.mmu_segmentation.push_back(get_attribute_value_string(attributes, num_attributes, MMU_SEGMENTATION_ATTR));
+        // single pass over the attributes, see _handle_start_vertex()
+        Vec3i32 triangle = Vec3i32::Zero();
+        const char *custom_supports  = nullptr;
+        const char *custom_seam      = nullptr;
+        const char *mmu_segmentation = nullptr;
+        if (attributes != nullptr && num_attributes % 2 == 0) {
+            for (unsigned int a = 0; a < num_attributes; a += 2) {
+                const char *key  = attributes[a];
+                const char *text = attributes[a + 1];
+                if (key[0] == 'v' && key[1] >= '1' && key[1] <= '3' && key[2] == 0)
+                    boost::spirit::qi::parse(text, text + strlen(text), boost::spirit::qi::int_, triangle[key[1] - '1']);
+                else if (::strcmp(key, CUSTOM_SUPPORTS_ATTR) == 0)
+                    custom_supports = text;
+                else if (::strcmp(key, CUSTOM_SEAM_ATTR) == 0)
+                    custom_seam = text;
+                else if (::strcmp(key, MMU_SEGMENTATION_ATTR) == 0)
+                    mmu_segmentation = text;
+            }
+        }
+        m_curr_object.geometry.triangles.emplace_back(triangle);
+
+        m_curr_object.geometry.custom_supports.emplace_back(custom_supports ? custom_supports : "");
+        m_curr_object.geometry.custom_seam.emplace_back(custom_seam ? custom_seam : "");
+        m_curr_object.geometry.mmu_segmentation.emplace_back(mmu_segmentation ? mmu_segmentation : "");
         return true;
     }
 
@@ -2090,39 +2159,25 @@ namespace Slic3r {
         return true;
     }
 
-    bool _3MF_Importer::_generate_volumes(ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, ConfigSubstitutionContext& config_substitutions, DynamicPrintConfig& global_config)
+    bool _3MF_Importer::_build_volume_meshes(const ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, std::vector<TriangleMesh>& meshes, std::string& error) const
     {
-        if (!object.volumes.empty()) {
-            add_error("Found invalid volumes count");
-            return false;
-        }
+        meshes.clear();
+        meshes.reserve(volumes.size());
 
         unsigned int geo_tri_count = (unsigned int)geometry.triangles.size();
-        unsigned int renamed_volumes_count = 0;
 
         for (const ObjectMetadata::VolumeMetadata& volume_data : volumes) {
             if (geo_tri_count <= volume_data.first_triangle_id || geo_tri_count <= volume_data.last_triangle_id || volume_data.last_triangle_id < volume_data.first_triangle_id) {
-                add_error("Found invalid triangle id");
+                error = "Found invalid triangle id";
                 return false;
             }
 
-            Transform3d volume_matrix_to_object = Transform3d::Identity();
-            bool        has_transform 		    = false;
-            // extract the volume transformation from the volume's metadata, if present
-            for (const Metadata& metadata : volume_data.metadata) {
-                if (metadata.key == MATRIX_KEY) {
-                    volume_matrix_to_object = Slic3r::Geometry::transform3d_from_string(metadata.value);
-                    has_transform 			= ! volume_matrix_to_object.isApprox(Transform3d::Identity(), 1e-10);
-                    break;
-                }
-            }
-
             // splits volume out of imported geometry
             indexed_triangle_set its;
             its.indices.assign(geometry.triangles.begin() + volume_data.first_triangle_id, geometry.triangles.begin() + volume_data.last_triangle_id + 1);
             const size_t triangles_count = its.indices.size();
             if (triangles_count == 0) {
-                add_error("An empty triangle mesh found");
+                error = "An empty triangle mesh found";
                 return false;
             }
 
@@ -2132,7 +2187,7 @@ namespace Slic3r {
                 for (const Vec3i32& face : its.indices) {
                     for (const int tri_id : face) {
                         if (tri_id < 0 || tri_id >= int(geometry.vertices.size())) {
-                            add_error("Found invalid vertex id");
+                            error = "Found invalid vertex id";
                             return false;
                         }
                         min_id = std::min(min_id, tri_id);
@@ -2160,16 +2215,61 @@ namespace Slic3r {
                 // if the 3mf was not produced by PrusaSlicer and there is only one instance,
                 // bake the transformation into the geometry to allow the reload from disk command
                 // to work properly
-                if (object.instances.size() == 1) {
+                // The instance transformation is reset by _generate_volumes() once baked into the first volume.
+                if (object.instances.size() == 1 && meshes.empty()) {
                     triangle_mesh.transform(object.instances.front()->get_transformation().get_matrix(), false);
-                    object.instances.front()->set_transformation(Slic3r::Geometry::Transformation());
                     //FIXME do the mesh fixing?
                 }
             }
             if (triangle_mesh.volume() < 0)
                 triangle_mesh.flip_triangles();
 
-			ModelVolume* volume = object.add_volume(std::move(triangle_mesh));
+            meshes.emplace_back(std::move(triangle_mesh));
+        }
+
+        return true;
+    }
+
+    bool _3MF_Importer::_generate_volumes(ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, ConfigSubstitutionContext& config_substitutions, DynamicPrintConfig& global_config)
+    {
+        std::vector<TriangleMesh> meshes;
+        std::string               error;
+        if (!_build_volume_meshes(object, geometry, volumes, meshes, error)) {
+            add_error(error);
+            return false;
+        }
+        return _generate_volumes(object, geometry, volumes, std::move(meshes), config_substitutions, global_config);
+    }
+
+    bool _3MF_Importer::_generate_volumes(ModelObject& object, const Geometry& geometry, const ObjectMetadata::VolumeMetadataList& volumes, std::vector<TriangleMesh>&& meshes, ConfigSubstitutionContext& config_substitutions, DynamicPrintConfig& global_config)
+    {
+        if (!object.volumes.empty()) {
+            add_error("Found invalid volumes count");
+            return false;
+        }
+        assert(meshes.size() == volumes.size());
+
+        if (m_version == 0 && object.instances.size() == 1 && !volumes.empty())
+            // the instance transformation was baked into the first volume by _build_volume_meshes()
+            object.instances.front()->set_transformation(Slic3r::Geometry::Transformation());
+
+        unsigned int renamed_volumes_count = 0;
+
+        for (size_t volume_idx = 0; volume_idx < volumes.size(); ++volume_idx) {
+            const ObjectMetadata::VolumeMetadata& volume_data = volumes[volume_idx];
+            Transform3d volume_matrix_to_object = Transform3d::Identity();
+            bool        has_transform 		    = false;
+            // extract the volume transformation from the volume's metadata, if present
+            for (const Metadata& metadata : volume_data.metadata) {
+                if (metadata.key == MATRIX_KEY) {
+                    volume_matrix_to_object = Slic3r::Geometry::transform3d_from_string(metadata.value);
+                    has_transform 			= ! volume_matrix_to_object.isApprox(Transform3d::Identity(), 1e-10);
+                    break;
+                }
+            }
+
+            const size_t triangles_count = volume_data.last_triangle_id - volume_data.first_triangle_id + 1;
+			ModelVolume* volume = object.add_volume(std::move(meshes[volume_idx]));
             // stores the volume matrix taken from the metadata, if present
             if (has_transform)
                 volume->source.transform = Slic3r::Geometry::Transformation(volume_matrix_to_object);
@@ -2330,6 +2430,9 @@ namespace Slic3r {
 
         OptionStore3mf m_options{};
 
+        // Level and flags passed to the zip writer for all the archive entries.
+        mz_uint compression_level() const { return m_options.compression_level < 0 ? mz_uint(MZ_DEFAULT_COMPRESSION) : mz_uint(std::min(m_options.compression_level, int(MZ_UBER_COMPRESSION))); }
+
     public:
         bool save_model_to_file(const std::string& filename, Model& model, const DynamicPrintConfig* config, const OptionStore3mf& options);
 
@@ -2510,7 +2613,7 @@ namespace Slic3r {
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, CONTENT_TYPES_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!mz_zip_writer_add_mem(&archive, CONTENT_TYPES_FILE.c_str(), (const void*)out.data(), out.length(), compression_level())) {
             add_error("Unable to add content types file to archive");
             return false;
         }
@@ -2525,7 +2628,7 @@ namespace Slic3r {
         size_t png_size = 0;
         void* png_data = tdefl_write_image_to_png_file_in_memory_ex((const void*)thumbnail_data.pixels.data(), thumbnail_data.width, thumbnail_data.height, 4, &png_size, MZ_DEFAULT_LEVEL, 1);
         if (png_data != nullptr) {
-            res = mz_zip_writer_add_mem(&archive, THUMBNAIL_FILE.c_str(), (const void*)png_data, png_size, MZ_DEFAULT_COMPRESSION);
+            res = mz_zip_writer_add_mem(&archive, THUMBNAIL_FILE.c_str(), (const void*)png_data, png_size, compression_level());
             mz_free(png_data);
         }
 
@@ -2546,7 +2649,7 @@ namespace Slic3r {
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, RELATIONSHIPS_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!mz_zip_writer_add_mem(&archive, RELATIONSHIPS_FILE.c_str(), (const void*)out.data(), out.length(), compression_level())) {
             add_error("Unable to add relationships file to archive");
             return false;
         }
@@ -2576,7 +2679,7 @@ namespace Slic3r {
                 // Maximum expected 3MF file size is 4GB-1. This is a workaround for interoperability with Windows 10 3D model fixing API, see
                 // GH issue #6193.
                 (uint64_t(1) << 32) - 1,
-            nullptr, nullptr, 0, MZ_DEFAULT_COMPRESSION, nullptr, 0, nullptr, 0)) {
+            nullptr, nullptr, 0, compression_level(), nullptr, 0, nullptr, 0)) {
             add_error("Unable to add model file to archive");
             return false;
         }
@@ -2734,6 +2837,34 @@ namespace Slic3r {
     using coordinate_type_scientific = boost::spirit::karma::real_generator<float, coordinate_policy_scientific<float>>;
 #endif // EXPORT_3MF_USE_SPIRIT_KARMA_FP
 
+    // Serializes the items [0, count) into text blocks of block_size items in parallel, then passes the blocks to the output
+    // in their original order. Only a bounded batch of blocks is kept in memory at a time, so that the text
+    // of a huge mesh is never held in memory as a whole.
+    template<typename SerializeFn, typename OutputFn>
+    static bool serialize_blocks_parallel(size_t count, size_t block_size, SerializeFn serialize, OutputFn output)
+    {
+        const size_t num_blocks      = (count + block_size - 1) / block_size;
+        const size_t blocks_in_batch = std::max<size_t>(1, 4 * size_t(tbb::this_task_arena::max_concurrency()));
+        std::vector<std::string> blocks(std::min(num_blocks, blocks_in_batch));
+        for (size_t batch_begin = 0; batch_begin < num_blocks; batch_begin += blocks_in_batch) {
+            const size_t batch_end = std::min(num_blocks, batch_begin + blocks_in_batch);
+            tbb::parallel_for(tbb::blocked_range<size_t>(batch_begin, batch_end, 1),
+                [&blocks, &serialize, batch_begin, block_size, count](const tbb::blocked_range<size_t> &range) {
+                    // The numeric locale is set per thread on some platforms.
+                    CNumericLocalesSetter locales_setter;
+                    for (size_t iblock = range.begin(); iblock < range.end(); ++ iblock) {
+                        std::string &out = blocks[iblock - batch_begin];
+                        out.clear();
+                        serialize(iblock * block_size, std::min(count, (iblock + 1) * block_size), out);
+                    }
+                });
+            for (size_t iblock = batch_begin; iblock < batch_end; ++ iblock)
+                if (! output(blocks[iblock - batch_begin]))
+                    return false;
+        }
+        return true;
+    }
+
     bool _3MF_Exporter::_add_mesh_to_object_stream(mz_zip_writer_staged_context &context, ModelObject& object, VolumeToOffsetsMap& volumes_offsets)
     {
         std::string output_buffer;
@@ -2754,6 +2885,17 @@ namespace Slic3r {
             return true;
         };
 
+        auto output_block = [this, &output_buffer, &context, &flush](const std::string &block) {
+            // Pass the pending header to the archive first to keep the order of the data.
+            if (! flush(true))
+                return false;
+            if (! block.empty() && ! mz_zip_writer_add_staged_data(&context, block.data(), block.size())) {
+                add_error("Error during writing or compression");
+                return false;
+            }
+            return true;
+        };
+
         auto format_coordinate = [](float f, char *buf) -> char* {
             assert(is_decimal_separator_point());
 #if EXPORT_3MF_USE_SPIRIT_KARMA_FP
@@ -2784,40 +2926,73 @@ namespace Slic3r {
 #endif
         };
 
-        char buf[256];
-        unsigned int vertices_count = 0;
+        // Non-empty volumes with their first vertex / first triangle indices into the vertices / triangles of the object.
+        // The vertices and triangles of all the volumes are serialized in parallel blocks, which may span multiple volumes.
+        struct VolumeData
+        {
+            const ModelVolume          *volume;
+            const indexed_triangle_set *its;
+            Transform3d                 matrix;
+            bool                        is_left_handed;
+            unsigned int                first_vertex_id;
+            unsigned int                first_triangle_id;
+        };
+        std::vector<VolumeData> volumes;
+        std::vector<size_t>     vertex_offsets;
+        std::vector<size_t>     triangle_offsets;
+        unsigned int vertices_count  = 0;
+        unsigned int triangles_count = 0;
         for (ModelVolume* volume : object.volumes) {
             if (volume == nullptr)
                 continue;
 
-            volumes_offsets.insert({ volume, Offsets(vertices_count) });
-
             const indexed_triangle_set &its = volume->mesh().its;
             if (its.vertices.empty()) {
                 add_error("Found invalid mesh");
                 return false;
             }
 
-            vertices_count += (int)its.vertices.size();
+            // updates vertex and triangle offsets
+            Offsets &offsets = volumes_offsets.insert({ volume, Offsets(vertices_count) }).first->second;
+            offsets.first_triangle_id = triangles_count;
+            volumes.push_back({ volume, &its, volume->get_matrix(), volume->is_left_handed(), vertices_count, triangles_count });
+            vertex_offsets.emplace_back(vertices_count);
+            triangle_offsets.emplace_back(triangles_count);
+            vertices_count  += (int)its.vertices.size();
+            triangles_count += (int)its.indices.size();
+            offsets.last_triangle_id = triangles_count - 1;
+        }
+        vertex_offsets.emplace_back(vertices_count);
+        triangle_offsets.emplace_back(triangles_count);
 
-            const Transform3d& matrix = volume->get_matrix();
+        // Index of the volume containing the item with the given index into the object's vertices / triangles.
+        auto volume_of = [](const std::vector<size_t> &offsets, size_t item_id) {
+            return size_t(std::upper_bound(offsets.begin(), offsets.end(), item_id) - offsets.begin()) - 1;
+        };
 
-            for (size_t i = 0; i < its.vertices.size(); ++i) {
-                Vec3f v = (matrix * its.vertices[i].cast<double>()).cast<float>();
-                char *ptr = buf;
-                boost::spirit::karma::generate(ptr, boost::spirit::lit("     <") << VERTEX_TAG << " x=\"");
-                ptr = format_coordinate(v.x(), ptr);
-                boost::spirit::karma::generate(ptr, "\" y=\"");
-                ptr = format_coordinate(v.y(), ptr);
-                boost::spirit::karma::generate(ptr, "\" z=\"");
-                ptr = format_coordinate(v.z(), ptr);
-                boost::spirit::karma::generate(ptr, "\"/>\n");
-                *ptr = '\0';
-                output_buffer += buf;
-                if (! flush())
-                    return false;
-            }
-        }
+        // Large enough to amortize the synchronization, small enough to balance the load over the worker threads.
+        static constexpr const size_t block_size = 16384;
+
+        if (! serialize_blocks_parallel(vertices_count, block_size,
+            [&volumes, &vertex_offsets, &volume_of, &format_coordinate](size_t begin, size_t end, std::string &out) {
+                char buf[256];
+                for (size_t ivolume = volume_of(vertex_offsets, begin), i = begin; i < end; ++ i) {
+                    while (i >= vertex_offsets[ivolume + 1])
+                        ++ ivolume;
+                    const VolumeData &volume = volumes[ivolume];
+                    Vec3f v = (volume.matrix * volume.its->vertices[i - volume.first_vertex_id].cast<double>()).cast<float>();
+                    char *ptr = buf;
+                    boost::spirit::karma::generate(ptr, boost::spirit::lit("     <") << VERTEX_TAG << " x=\"");
+                    ptr = format_coordinate(v.x(), ptr);
+                    boost::spirit::karma::generate(ptr, "\" y=\"");
+                    ptr = format_coordinate(v.y(), ptr);
+                    boost::spirit::karma::generate(ptr, "\" z=\"");
+                    ptr = format_coordinate(v.z(), ptr);
+                    boost::spirit::karma::generate(ptr, "\"/>\n");
+                    out.append(buf, ptr);
+                }
+            }, output_block))
+            return false;
 
         output_buffer += "    </";
         output_buffer += VERTICES_TAG;
@@ -2825,70 +3000,58 @@ namespace Slic3r {
         output_buffer += TRIANGLES_TAG;
         output_buffer += ">\n";
 
-        unsigned int triangles_count = 0;
-        for (ModelVolume* volume : object.volumes) {
-            if (volume == nullptr)
-                continue;
-
-            bool is_left_handed = volume->is_left_handed();
-            VolumeToOffsetsMap::iterator volume_it = volumes_offsets.find(volume);
-            assert(volume_it != volumes_offsets.end());
-
-            const indexed_triangle_set &its = volume->mesh().its;
-
-            // updates triangle offsets
-            volume_it->second.first_triangle_id = triangles_count;
-            triangles_count += (int)its.indices.size();
-            volume_it->second.last_triangle_id = triangles_count - 1;
+        if (! serialize_blocks_parallel(triangles_count, block_size,
+            [&volumes, &triangle_offsets, &volume_of](size_t begin, size_t end, std::string &out) {
+                char buf[256];
+                for (size_t ivolume = volume_of(triangle_offsets, begin), j = begin; j < end; ++ j) {
+                    while (j >= triangle_offsets[ivolume + 1])
+                        ++ ivolume;
+                    const VolumeData &volume = volumes[ivolume];
+                    const int         i      = int(j - volume.first_triangle_id);
+                    {
+                        const Vec3i32&idx = volume.its->indices[i];
+                        char *ptr = buf;
+                        boost::spirit::karma::generate(ptr, boost::spirit::lit("     <") << TRIANGLE_TAG <<
+                            " v1=\"" << boost::spirit::int_ <<
+                            "\" v2=\"" << boost::spirit::int_ <<
+                            "\" v3=\"" << boost::spirit::int_ << "\"",
+                            idx[volume.is_left_handed ? 2 : 0] + volume.first_vertex_id,
+                            idx[1] + volume.first_vertex_id,
+                            idx[volume.is_left_handed ? 0 : 2] + volume.first_vertex_id);
+                        out.append(buf, ptr);
+                    }
 
-            for (int i = 0; i < int(its.indices.size()); ++ i) {
-                {
-                    const Vec3i32&idx = its.indices[i];
-                    char *ptr = buf;
-                    boost::spirit::karma::generate(ptr, boost::spirit::lit("     <") << TRIANGLE_TAG <<
-                        " v1=\"" << boost::spirit::int_ <<
-                        "\" v2=\"" << boost::spirit::int_ <<
-                        "\" v3=\"" << boost::spirit::int_ << "\"",
-                        idx[is_left_handed ? 2 : 0] + volume_it->second.first_vertex_id,
-                        idx[1] + volume_it->second.first_vertex_id,
-                        idx[is_left_handed ? 0 : 2] + volume_it->second.first_vertex_id);
-                    *ptr = '\0';
-                    output_buffer += buf;
-                }
+                    std::string custom_supports_data_string = volume.volume->supported_facets.get_triangle_as_string(i);
+                    if (! custom_supports_data_string.empty()) {
+                        out += " ";
+                        out += CUSTOM_SUPPORTS_ATTR;
+                        out += "=\"";
+                        out += custom_supports_data_string;
+                        out += "\"";
+                    }
 
-                std::string custom_supports_data_string = volume->supported_facets.get_triangle_as_string(i);
-                if (! custom_supports_data_string.empty()) {
-                    output_buffer += " ";
-                    output_buffer += CUSTOM_SUPPORTS_ATTR;
-                    output_buffer += "=\"";
-                    output_buffer += custom_supports_data_string;
-                    output_buffer += "\"";
-                }
+                    std::string custom_seam_data_string = volume.volume->seam_facets.get_triangle_as_string(i);
+                    if (! custom_seam_data_string.empty()) {
+                        out += " ";
+                        out += CUSTOM_SEAM_ATTR;
+                        out += "=\"";
+                        out += custom_seam_data_string;
+                        out += "\"";
+                    }
 
-                std::string custom_seam_data_string = volume->seam_facets.get_triangle_as_string(i);
-                if (! custom_seam_data_string.empty()) {
-                    output_buffer += " ";
-                    output_buffer += CUSTOM_SEAM_ATTR;
-                    output_buffer += "=\"";
-                    output_buffer += custom_seam_data_string;
-                    output_buffer += "\"";
-                }
+                    std::string mmu_painting_data_string = volume.volume->mmu_segmentation_facets.get_triangle_as_string(i);
+                    if (! mmu_painting_data_string.empty()) {
+                        out += " ";
+                        out += MMU_SEGMENTATION_ATTR;
+                        out += "=\"";
+                        out += mmu_painting_data_string;
+                        out += "\"";
+                    }
 
-                std::string mmu_painting_data_string = volume->mmu_segmentation_facets.get_triangle_as_string(i);
-                if (! mmu_painting_data_string.empty()) {
-                    output_buffer += " ";
-                    output_buffer += MMU_SEGMENTATION_ATTR;
-                    output_buffer += "=\"";
-                    output_buffer += mmu_painting_data_string;
-                    output_buffer += "\"";
+                    out += "/>\n";
                 }
-
-                output_buffer += "/>\n";
-
-                if (! flush())
-                    return false;
-            }
-        }
+            }, output_block))
+            return false;
 
         output_buffer += "    </";
         output_buffer += TRIANGLES_TAG;
@@ -2952,7 +3115,7 @@ namespace Slic3r {
         }
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, LAYER_HEIGHTS_PROFILE_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!mz_zip_writer_add_mem(&archive, LAYER_HEIGHTS_PROFILE_FILE.c_str(), (const void*)out.data(), out.length(), compression_level())) {
                 add_error("Unable to add layer heights profile file to archive");
                 return false;
             }
@@ -3063,16 +3226,16 @@ namespace Slic3r {
         }
 
         if (!default_out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, SLIC3R_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)default_out.data(), default_out.length(), MZ_DEFAULT_COMPRESSION))
+            if (!mz_zip_writer_add_mem(&archive, SLIC3R_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)default_out.data(), default_out.length(), compression_level()))
             {
                 add_error("Unable to add layer heights profile file to archive");
                 return false;
             }
-            if (!mz_zip_writer_add_mem(&archive, SUPER_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)default_out.data(), default_out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!mz_zip_writer_add_mem(&archive, SUPER_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)default_out.data(), default_out.length(), compression_level())) {
                 add_error("Unable to add layer heights profile file to archive");
                 return false;
             }
-            if (!prusa_out.empty() && !mz_zip_writer_add_mem(&archive, PRUSA_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)prusa_out.data(), prusa_out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!prusa_out.empty() && !mz_zip_writer_add_mem(&archive, PRUSA_LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)prusa_out.data(), prusa_out.length(), compression_level())) {
                 add_error("Unable to add layer heights profile file to archive");
                 return false;
             }
@@ -3108,7 +3271,7 @@ namespace Slic3r {
             // Adds version header at the beginning:
             out = std::string("support_points_format_version=") + std::to_string(support_points_format_version) + std::string("\n") + out;
 
-            if (!mz_zip_writer_add_mem(&archive, SLA_SUPPORT_POINTS_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!mz_zip_writer_add_mem(&archive, SLA_SUPPORT_POINTS_FILE.c_str(), (const void*)out.data(), out.length(), compression_level())) {
                 add_error("Unable to add sla support points file to archive");
                 return false;
             }
@@ -3159,7 +3322,7 @@ namespace Slic3r {
             // Adds version header at the beginning:
             out = std::string("drain_holes_format_version=") + std::to_string(drain_holes_format_version) + std::string("\n") + out;
             
-            if (!mz_zip_writer_add_mem(&archive, SLA_DRAIN_HOLES_FILE.c_str(), static_cast<const void*>(out.data()), out.length(), mz_uint(MZ_DEFAULT_COMPRESSION))) {
+            if (!mz_zip_writer_add_mem(&archive, SLA_DRAIN_HOLES_FILE.c_str(), static_cast<const void*>(out.data()), out.length(), compression_level())) {
                 add_error("Unable to add sla support points file to archive");
                 return false;
             }
@@ -3188,7 +3351,7 @@ namespace Slic3r {
         }
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, config_name.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!mz_zip_writer_add_mem(&archive, config_name.c_str(), (const void*)out.data(), out.length(), compression_level())) {
                 add_error("Unable to add print config file to archive");
                 return false;
             }
@@ -3415,7 +3578,7 @@ namespace Slic3r {
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, file_path.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!mz_zip_writer_add_mem(&archive, file_path.c_str(), (const void*)out.data(), out.length(), compression_level())) {
             add_error("Unable to add model config file to archive");
             return false;
         }
@@ -3467,7 +3630,7 @@ bool _3MF_Exporter::_add_custom_gcode_per_print_z_file_to_archive( mz_zip_archiv
     } 
 
     if (!out.empty()) {
-        if (!mz_zip_writer_add_mem(&archive, CUSTOM_GCODE_PER_PRINT_Z_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!mz_zip_writer_add_mem(&archive, CUSTOM_GCODE_PER_PRINT_Z_FILE.c_str(), (const void*)out.data(), out.length(), compression_level())) {
             add_error("Unable to add custom Gcodes per print_z file to archive");
             return false;
         }
@@ -40,11 +40,14 @@ namespace Slic3r {
         bool zip64 = true;
         bool export_config = true;
         bool export_modifiers = true;
+        // Deflate level of the archive entries, from 0 (store only) to 10 (best compression), -1 for the zip library default.
+        int compression_level = -1;
         const ThumbnailData* thumbnail_data = nullptr;
         OptionStore3mf& set_fullpath_sources(bool use_fullpath_sources) { fullpath_sources = use_fullpath_sources; return *this; }
         OptionStore3mf& set_zip64(bool use_zip64) { zip64 = use_zip64; return *this; }
         OptionStore3mf& set_export_config(bool use_export_config) { export_config = use_export_config; return *this; }
         OptionStore3mf& set_export_modifiers(bool use_export_modifiers) { export_modifiers = use_export_modifiers; return *this; }
+        OptionStore3mf& set_compression_level(int level) { compression_level = level; return *this; }
         OptionStore3mf& set_thumbnail_data(const ThumbnailData* thumbnail) { thumbnail_data = thumbnail; return *this; }
     };
 
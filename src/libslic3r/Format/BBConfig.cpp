@@ -454,11 +454,11 @@ void init()
     value_translation_map["filament_type"]["TPU"] = "FLEX";
     value_translation_map["support_material_style"]["normal"] = "grid";
     value_translation_map["support_material_style"]["default"] = "grid";
-    value_translation_map["support_material_style"]["tree"] = "snug"; // organic in 2.7
-    value_translation_map["support_material_style"]["tree_slim"] = "snug"; // organic in 2.7
-    value_translation_map["support_material_style"]["tree_strong"] = "snug"; // organic in 2.7
-    value_translation_map["support_material_style"]["tree_hybrid"] = "snug"; // organic in 2.7
-    value_translation_map["support_material_style"]["organic"] = "snug"; // organic in 2.7
+    value_translation_map["support_material_style"]["tree"] = "tree";
+    value_translation_map["support_material_style"]["tree_slim"] = "tree";
+    value_translation_map["support_material_style"]["tree_strong"] = "tree";
+    value_translation_map["support_material_style"]["tree_hybrid"] = "tree";
+    value_translation_map["support_material_style"]["organic"] = "tree";
     value_translation_map["retract_lift_top"]["Bottom Only"] = "Not on top";
     value_translation_map["retract_lift_top"]["Top Only"] = "Only on top";
     value_translation_map["thumbnails_format"]["BTT_TFT"] = "BIQU";
@@ -0,0 +1,294 @@
+#include "../libslic3r.h"
+#include "../Model.hpp"
+#include "../TriangleMesh.hpp"
+
+#include "MeshCache.hpp"
+#include "STEP.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
+//FIXME replace with <boost/md5.hpp> after it becomes mainstream, see AppConfig::appconfig_md5_hash_line().
+#include <boost/uuid/detail/md5.hpp>
+
+namespace Slic3r {
+
+static std::string g_mesh_cache_dir;
+
+void set_mesh_cache_dir(const std::string &dir)
+{
+    g_mesh_cache_dir = dir;
+}
+
+const std::string& mesh_cache_dir()
+{
+    return g_mesh_cache_dir;
+}
+
+bool is_mesh_cache_supported(const std::string &path)
+{
+    return boost::algorithm::iends_with(path, ".stl") || boost::algorithm::iends_with(path, ".obj") ||
+           boost::algorithm::iends_with(path, ".step") || boost::algorithm::iends_with(path, ".stp");
+}
+
+// Bump whenever the layout of the cache file or the output of the loaders changes.
+static constexpr const uint32_t MESH_CACHE_VERSION = 1;
+static constexpr const char     MESH_CACHE_MAGIC[8] = { 'S', 'S', 'M', 'E', 'S', 'H', 'C', '\0' };
+
+struct MeshCacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t num_objects;
+};
+
+// TriangleMeshStats stored field by field, Eigen types are not guaranteed to be trivially copyable.
+struct MeshCacheStats
+{
+    uint32_t number_of_facets;
+    float    max[3];
+    float    min[3];
+    float    size[3];
+    float    volume;
+    int32_t  number_of_parts;
+    int32_t  open_edges;
+    int32_t  edges_fixed;
+    int32_t  degenerate_facets;
+    int32_t  facets_removed;
+    int32_t  facets_reversed;
+    int32_t  backwards_edges;
+};
+
+struct MeshCacheVolume
+{
+    // Transformation of the volume set by the loader when centering its mesh, see ModelVolume::center_geometry_after_creation().
+    double         offset[3];
+    double         source_mesh_offset[3];
+    double         init_shift[3];
+    MeshCacheStats stats;
+    uint32_t       num_vertices;
+    uint32_t       num_indices;
+};
+
+// Key of the cache entry: MD5 of the file name and file content.
+// The file name is part of the key, as the loaders derive the object names from it.
+// STEP files are tessellated, thus the tessellation tolerances are part of the key as well.
+static std::string mesh_cache_key(const char *path)
+{
+    boost::nowide::ifstream ifs(path, std::ios::binary);
+    if (! ifs.good())
+        return {};
+
+    using boost::uuids::detail::md5;
+    md5 md5_hash;
+    const std::string filename = boost::filesystem::path(path).filename().string();
+    md5_hash.process_bytes(filename.data(), filename.size() + 1);
+    if (boost::algorithm::iends_with(filename, ".step") || boost::algorithm::iends_with(filename, ".stp")) {
+        const double deflection[2] = { step_linear_deflection(), step_angular_deflection() };
+        md5_hash.process_bytes(deflection, sizeof(deflection));
+    }
+    std::vector<char> buffer(1 << 20);
+    while (ifs) {
+        ifs.read(buffer.data(), buffer.size());
+        if (ifs.gcount() > 0)
+            md5_hash.process_bytes(buffer.data(), size_t(ifs.gcount()));
+    }
+    if (! ifs.eof())
+        return {};
+
+    md5::digest_type md5_digest{};
+    md5_hash.get_digest(md5_digest);
+    std::string key;
+    boost::algorithm::hex(md5_digest, md5_digest + std::size(md5_digest), std::back_inserter(key));
+    return key;
+}
+
+static boost::filesystem::path mesh_cache_path(const std::string &key)
+{
+    return boost::filesystem::path(g_mesh_cache_dir) / (key + ".meshcache");
+}
+
+// Strings are stored as a 32bit length followed by the characters padded to 4 bytes, so that the arrays of vertices and indices stay aligned.
+static void write_string(std::ostream &os, const std::string &str)
+{
+    static constexpr const char padding[4] = { 0, 0, 0, 0 };
+    uint32_t len = uint32_t(str.size());
+    os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    os.write(str.data(), len);
+    os.write(padding, (4 - len % 4) % 4);
+}
+
+static bool read_string(std::istream &is, std::string &str)
+{
+    uint32_t len = 0;
+    if (! is.read(reinterpret_cast<char*>(&len), sizeof(len)))
+        return false;
+    str.assign(len + (4 - len % 4) % 4, '\0');
+    if (! is.read(str.data(), str.size()))
+        return false;
+    str.resize(len);
+    return true;
+}
+
+bool load_mesh_cache(const char *path, Model *model)
+{
+    if (g_mesh_cache_dir.empty())
+        return false;
+
+    const std::string key = mesh_cache_key(path);
+    if (key.empty())
+        return false;
+    const boost::filesystem::path cache_path = mesh_cache_path(key);
+    boost::nowide::ifstream ifs(cache_path.string(), std::ios::binary);
+    if (! ifs.good())
+        return false;
+
+    Model loaded;
+    auto read_cache = [&ifs, &loaded, path]() {
+        MeshCacheHeader header;
+        if (! ifs.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) != 0 || header.version != MESH_CACHE_VERSION || header.num_objects == 0)
+            return false;
+        for (uint32_t iobject = 0; iobject < header.num_objects; ++ iobject) {
+            ModelObject *object = loaded.add_object();
+            object->input_file = path;
+            uint32_t num_volumes = 0;
+            if (! read_string(ifs, object->name) || ! ifs.read(reinterpret_cast<char*>(&num_volumes), sizeof(num_volumes)))
+                return false;
+            for (uint32_t ivolume = 0; ivolume < num_volumes; ++ ivolume) {
+                std::string     name;
+                MeshCacheVolume volume_data;
+                if (! read_string(ifs, name) || ! ifs.read(reinterpret_cast<char*>(&volume_data), sizeof(volume_data)) ||
+                    volume_data.stats.number_of_facets != volume_data.num_indices)
+                    return false;
+                indexed_triangle_set its;
+                its.vertices.resize(volume_data.num_vertices);
+                its.indices.resize(volume_data.num_indices);
+                if (! ifs.read(reinterpret_cast<char*>(its.vertices.data()), its.vertices.size() * sizeof(stl_vertex)) ||
+                    ! ifs.read(reinterpret_cast<char*>(its.indices.data()), its.indices.size() * sizeof(stl_triangle_vertex_indices)))
+                    return false;
+                for (const stl_triangle_vertex_indices &face : its.indices)
+                    for (int i = 0; i < 3; ++ i)
+                        if (face[i] < 0 || face[i] >= int(its.vertices.size()))
+                            return false;
+
+                const MeshCacheStats &s = volume_data.stats;
+                TriangleMeshStats stats;
+                stats.number_of_facets                  = s.number_of_facets;
+                stats.max                               = stl_vertex(s.max[0], s.max[1], s.max[2]);
+                stats.min                               = stl_vertex(s.min[0], s.min[1], s.min[2]);
+                stats.size                              = stl_vertex(s.size[0], s.size[1], s.size[2]);
+                stats.volume                            = s.volume;
+                stats.number_of_parts                   = s.number_of_parts;
+                stats.open_edges                        = s.open_edges;
+                stats.repaired_errors.edges_fixed       = s.edges_fixed;
+                stats.repaired_errors.degenerate_facets = s.degenerate_facets;
+                stats.repaired_errors.facets_removed    = s.facets_removed;
+                stats.repaired_errors.facets_reversed   = s.facets_reversed;
+                stats.repaired_errors.backwards_edges   = s.backwards_edges;
+
+                TriangleMesh mesh(std::move(its), stats);
+                mesh.set_init_shift(Vec3d(volume_data.init_shift[0], volume_data.init_shift[1], volume_data.init_shift[2]));
+                // The cached mesh has already been centered by the loader.
+                ModelVolume *volume = object->add_volume(std::move(mesh), ModelVolumeType::MODEL_PART, false);
+                volume->name = std::move(name);
+                volume->set_offset(Vec3d(volume_data.offset[0], volume_data.offset[1], volume_data.offset[2]));
+                volume->source.mesh_offset = Vec3d(volume_data.source_mesh_offset[0], volume_data.source_mesh_offset[1], volume_data.source_mesh_offset[2]);
+                volume->source.input_file  = path;
+                volume->source.object_idx  = int(loaded.objects.size()) - 1;
+                volume->source.volume_idx  = int(object->volumes.size()) - 1;
+            }
+            if (object->volumes.empty())
+                return false;
+        }
+        return true;
+    };
+
+    if (! read_cache()) {
+        BOOST_LOG_TRIVIAL(warning) << "Ignoring invalid mesh cache file " << cache_path.string() << " for " << path;
+        return false;
+    }
+
+    for (ModelObject *object : loaded.objects)
+        model->add_object(*object);
+    BOOST_LOG_TRIVIAL(debug) << "Loaded " << path << " from mesh cache " << cache_path.string();
+    return true;
+}
+
+bool store_mesh_cache(const char *path, const Model &model)
+{
+    if (g_mesh_cache_dir.empty() || model.objects.empty())
+        return false;
+
+    const std::string key = mesh_cache_key(path);
+    if (key.empty())
+        return false;
+
+    try {
+        boost::filesystem::create_directories(g_mesh_cache_dir);
+        const boost::filesystem::path cache_path = mesh_cache_path(key);
+        // Write into a temporary file first, so that a concurrent load of the same file never sees a partially written cache.
+        const boost::filesystem::path temp_path  = cache_path.string() + "." + boost::filesystem::unique_path().string() + ".tmp";
+        {
+            boost::nowide::ofstream ofs(temp_path.string(), std::ios::binary);
+            MeshCacheHeader header {};
+            memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+            header.version     = MESH_CACHE_VERSION;
+            header.num_objects = uint32_t(model.objects.size());
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const ModelObject *object : model.objects) {
+                write_string(ofs, object->name);
+                uint32_t num_volumes = uint32_t(object->volumes.size());
+                ofs.write(reinterpret_cast<const char*>(&num_volumes), sizeof(num_volumes));
+                for (const ModelVolume *volume : object->volumes) {
+                    const TriangleMesh      &mesh  = volume->mesh();
+                    const TriangleMeshStats &stats = mesh.stats();
+                    MeshCacheVolume volume_data {};
+                    for (int i = 0; i < 3; ++ i) {
+                        volume_data.offset[i]             = volume->get_offset()(i);
+                        volume_data.source_mesh_offset[i] = volume->source.mesh_offset(i);
+                        volume_data.init_shift[i]         = mesh.get_init_shift()(i);
+                        volume_data.stats.max[i]          = stats.max(i);
+                        volume_data.stats.min[i]          = stats.min(i);
+                        volume_data.stats.size[i]         = stats.size(i);
+                    }
+                    volume_data.stats.number_of_facets  = stats.number_of_facets;
+                    volume_data.stats.volume            = stats.volume;
+                    volume_data.stats.number_of_parts   = stats.number_of_parts;
+                    volume_data.stats.open_edges        = stats.open_edges;
+                    volume_data.stats.edges_fixed       = stats.repaired_errors.edges_fixed;
+                    volume_data.stats.degenerate_facets = stats.repaired_errors.degenerate_facets;
+                    volume_data.stats.facets_removed    = stats.repaired_errors.facets_removed;
+                    volume_data.stats.facets_reversed   = stats.repaired_errors.facets_reversed;
+                    volume_data.stats.backwards_edges   = stats.repaired_errors.backwards_edges;
+                    volume_data.num_vertices            = uint32_t(mesh.its.vertices.size());
+                    volume_data.num_indices             = uint32_t(mesh.its.indices.size());
+                    write_string(ofs, volume->name);
+                    ofs.write(reinterpret_cast<const char*>(&volume_data), sizeof(volume_data));
+                    ofs.write(reinterpret_cast<const char*>(mesh.its.vertices.data()), mesh.its.vertices.size() * sizeof(stl_vertex));
+                    ofs.write(reinterpret_cast<const char*>(mesh.its.indices.data()), mesh.its.indices.size() * sizeof(stl_triangle_vertex_indices));
+                }
+            }
+            if (! ofs.good()) {
+                ofs.close();
+                boost::filesystem::remove(temp_path);
+                BOOST_LOG_TRIVIAL(warning) << "Failed writing the mesh cache file " << temp_path.string();
+                return false;
+            }
+        }
+        boost::filesystem::rename(temp_path, cache_path);
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(warning) << "Failed storing " << path << " into the mesh cache: " << ex.what();
+        return false;
+    }
+    return true;
+}
+
+}; // namespace Slic3r
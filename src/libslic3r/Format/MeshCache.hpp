@@ -0,0 +1,27 @@
+#ifndef slic3r_Format_MeshCache_hpp_
+#define slic3r_Format_MeshCache_hpp_
+
+#include <string>
+
+namespace Slic3r {
+
+class Model;
+
+// On-disk cache of the models loaded from geometry only files (STL, OBJ, STEP), keyed by a hash of the file name and content.
+// A cache file stores the repaired meshes with their statistics in a flat binary layout (4 byte aligned arrays of vertices
+// and indices), so that loading a cached file skips parsing, repair and the calculation of the mesh statistics.
+// The cache is disabled unless a cache directory is set.
+extern void               set_mesh_cache_dir(const std::string &dir);
+extern const std::string& mesh_cache_dir();
+
+// Is the file of a format, which is loaded through the mesh cache?
+extern bool is_mesh_cache_supported(const std::string &path);
+
+// Load the model cached for the content of the file at path. Returns false if there is no valid cache entry.
+extern bool load_mesh_cache(const char *path, Model *model);
+// Store the model freshly loaded from the file at path into the cache.
+extern bool store_mesh_cache(const char *path, const Model &model);
+
+}; // namespace Slic3r
+
+#endif /* slic3r_Format_MeshCache_hpp_ */
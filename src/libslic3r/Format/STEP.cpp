@@ -9,9 +9,13 @@
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/log/trivial.hpp>
 
+#include <chrono>
 #include <string>
 #include <functional>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #ifdef _WIN32
     #include<windows.h>
 #else
@@ -23,9 +27,21 @@
 namespace Slic3r {
 
 #if __APPLE__
-extern "C" bool load_step_internal(const char *path, OCCTResult* res);
+extern "C" bool load_step_internal(const char *path, OCCTResult* res, double linear_deflection, double angular_deflection);
 #endif
 
+static double g_step_linear_deflection  = STEP_DEFAULT_LINEAR_DEFLECTION;
+static double g_step_angular_deflection = STEP_DEFAULT_ANGULAR_DEFLECTION;
+
+void set_step_deflection(double linear_deflection, double angular_deflection)
+{
+    g_step_linear_deflection  = linear_deflection  > 0. ? linear_deflection  : STEP_DEFAULT_LINEAR_DEFLECTION;
+    g_step_angular_deflection = angular_deflection > 0. ? angular_deflection : STEP_DEFAULT_ANGULAR_DEFLECTION;
+}
+
+double step_linear_deflection()  { return g_step_linear_deflection; }
+double step_angular_deflection() { return g_step_angular_deflection; }
+
 LoadStepFn get_load_step_fn()
 {
     static LoadStepFn load_step_fn = nullptr;
@@ -85,7 +101,12 @@ bool load_step(const char *path, Model *model /*BBS:, ImportStepProgressFn proFn
     if (!load_step_fn)
         return false;
 
-    load_step_fn(path, &occt_object);
+    auto time_start = std::chrono::steady_clock::now();
+    if (! load_step_fn(path, &occt_object, g_step_linear_deflection, g_step_angular_deflection)) {
+        BOOST_LOG_TRIVIAL(error) << "load_step: failed to load " << path << ". " << occt_object.error_str;
+        return false;
+    }
+    auto time_tessellated = std::chrono::steady_clock::now();
 
     assert(! occt_object.volumes.empty());
     
@@ -94,6 +115,26 @@ bool load_step(const char *path, Model *model /*BBS:, ImportStepProgressFn proFn
     occt_object.object_name.erase(occt_object.object_name.find("."));
     assert(! occt_object.object_name.empty());
 
+    // Merge the duplicate vertices at the face boundaries and calculate the mesh statistics of the solids in parallel.
+    std::vector<TriangleMesh> meshes(occt_object.volumes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, occt_object.volumes.size(), 1),
+        [&occt_object, &meshes](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i) {
+            OCCTVolume &volume = occt_object.volumes[i];
+            indexed_triangle_set its;
+            its.vertices.reserve(volume.vertices.size());
+            for (const std::array<float, 3> &v : volume.vertices)
+                its.vertices.emplace_back(v[0], v[1], v[2]);
+            its.indices.reserve(volume.indices.size());
+            for (const std::array<int, 3> &f : volume.indices)
+                its.indices.emplace_back(f[0], f[1], f[2]);
+            volume.vertices = {};
+            volume.indices  = {};
+            its_merge_vertices(its, true);
+            meshes[i] = TriangleMesh(std::move(its));
+        }
+    });
+    auto time_meshed = std::chrono::steady_clock::now();
 
     ModelObject* new_object = model->add_object();
     new_object->input_file = path;
@@ -104,18 +145,7 @@ bool load_step(const char *path, Model *model /*BBS:, ImportStepProgressFn proFn
 
 
     for (size_t i=0; i<occt_object.volumes.size(); ++i) {
-        indexed_triangle_set its;
-        for (size_t j=0; j<occt_object.volumes[i].vertices.size(); ++j)
-            its.vertices.emplace_back(Vec3f(occt_object.volumes[i].vertices[j][0],
-                                            occt_object.volumes[i].vertices[j][1],
-                                            occt_object.volumes[i].vertices[j][2]));
-        for (size_t j=0; j<occt_object.volumes[i].indices.size(); ++j)
-            its.indices.emplace_back(Vec3i32(occt_object.volumes[i].indices[j][0],
-                                           occt_object.volumes[i].indices[j][1],
-                                           occt_object.volumes[i].indices[j][2]));
-        its_merge_vertices(its, true);
-        TriangleMesh triangle_mesh(std::move(its));
-        ModelVolume* new_volume = new_object->add_volume(std::move(triangle_mesh));
+        ModelVolume* new_volume = new_object->add_volume(std::move(meshes[i]));
 
         new_volume->name = occt_object.volumes[i].volume_name.empty()
                        ? std::string("Part") + std::to_string(i+1)
@@ -125,6 +155,12 @@ bool load_step(const char *path, Model *model /*BBS:, ImportStepProgressFn proFn
         new_volume->source.volume_idx = (int)new_object->volumes.size() - 1;
     }
 
+    auto seconds = [](auto from, auto to) { return std::chrono::duration<double>(to - from).count(); };
+    BOOST_LOG_TRIVIAL(info) << "load_step: loaded " << occt_object.volumes.size() << " solids from " << path
+        << " in " << seconds(time_start, std::chrono::steady_clock::now()) << " s (reading and tessellation "
+        << seconds(time_start, time_tessellated) << " s, mesh repair " << seconds(time_tessellated, time_meshed)
+        << " s), linear deflection " << g_step_linear_deflection << " mm, angular deflection " << g_step_angular_deflection;
+
     return true;
 }
 
@@ -11,6 +11,12 @@ class Model;
 
 //typedef std::function<void(int load_stage, int current, int total, bool& cancel)> ImportStepProgressFn;
 
+// Tessellation tolerances used by load_step(): maximum chord deviation (mm) and maximum angle between adjacent triangles (radians).
+// Non-positive values reset the respective tolerance to its default.
+extern void   set_step_deflection(double linear_deflection, double angular_deflection);
+extern double step_linear_deflection();
+extern double step_angular_deflection();
+
 // Load a step file into a provided model.
 extern bool load_step(const char *path_str, Model *model /*LMBBS:, ImportStepProgressFn proFn = nullptr*/);
 
@@ -1,12 +1,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <fast_float/fast_float.h>
 
 #include "objparser.hpp"
 
 #include "libslic3r/LocalesUtils.hpp"
+#include "admesh/stl.h"
 
 namespace ObjParser {
 
@@ -401,6 +413,223 @@ bool objparse(std::istream &stream, ObjData &data)
     return true;
 }
 
+// Geometry of a continuous range of lines of an OBJ file, parsed by objparse_mesh().
+struct ObjMeshChunk
+{
+    std::vector<stl_vertex>                     vertices;
+    std::vector<stl_triangle_vertex_indices>    indices;
+    // Positions (triangle_idx * 3 + corner) of vertex indices referenced relative to the end of the vertex list.
+    // These are relative to the start of the chunk until the vertex offset of the chunk is known.
+    std::vector<size_t>                         relative;
+    size_t                                      vertex_offset   = 0;
+    size_t                                      triangle_offset = 0;
+    size_t                                      num_ignored     = 0;
+    std::string                                 error;
+};
+
+static inline bool is_obj_whitespace(char c) { return c == ' ' || c == '\t'; }
+static inline bool is_obj_eol(char c) { return c == '\n' || c == '\r'; }
+
+// Parse a vertex position "v x y z [w]". Anything past the z coordinate is ignored (w, vertex colors exported by Meshlab etc.).
+static bool obj_parse_vertex(const char *line, const char *end, stl_vertex &out)
+{
+    for (int i = 0; i < 3; ++ i) {
+        while (line != end && is_obj_whitespace(*line))
+            ++ line;
+        // fast_float does not accept the leading plus sign, which strtod() accepts.
+        if (line != end && *line == '+')
+            ++ line;
+        auto [ptr, ec] = fast_float::from_chars(line, end, out(i));
+        if (ec != std::errc() || (ptr != end && ! is_obj_whitespace(*ptr)))
+            return false;
+        line = ptr;
+    }
+    return true;
+}
+
+// Parse an OBJ vertex index (one based, negative if relative to the end of the vertex list).
+static inline const char* obj_parse_index(const char *line, const char *end, int &out)
+{
+    bool negative = false;
+    if (line != end && (*line == '-' || *line == '+'))
+        negative = *line ++ == '-';
+    if (line == end || *line < '0' || *line > '9')
+        return nullptr;
+    int64_t value = 0;
+    for (; line != end && *line >= '0' && *line <= '9'; ++ line)
+        if ((value = value * 10 + (*line - '0')) > std::numeric_limits<int>::max())
+            return nullptr;
+    out = negative ? - int(value) : int(value);
+    return line;
+}
+
+// Parse a face "f v1[/vt1[/vn1]] v2... ". Only the vertex position indices are retained, a quad is split into two triangles.
+// Returns false on a syntax error, sets chunk.error if the face is not supported.
+static bool obj_parse_face(const char *line, const char *end, ObjMeshChunk &chunk)
+{
+    int    indices[4];
+    bool   relative[4];
+    int    cnt = 0;
+    for (;;) {
+        while (line != end && is_obj_whitespace(*line))
+            ++ line;
+        if (line == end)
+            break;
+        int idx;
+        if ((line = obj_parse_index(line, end, idx)) == nullptr || idx == 0)
+            return false;
+        // Skip the texture coordinate and normal indices.
+        while (line != end && ! is_obj_whitespace(*line))
+            ++ line;
+        if (cnt == 4) {
+            chunk.error = "The file contains polygons with more than 4 vertices.";
+            return false;
+        }
+        relative[cnt] = idx < 0;
+        indices[cnt ++] = idx < 0 ? int(chunk.vertices.size()) + idx : idx - 1;
+    }
+    if (cnt < 3) {
+        chunk.error = "The file contains polygons with less than 3 vertices.";
+        return false;
+    }
+    auto emit = [&chunk, &indices, &relative](int i, int j, int k) {
+        size_t idx_first = chunk.indices.size() * 3;
+        chunk.indices.emplace_back(indices[i], indices[j], indices[k]);
+        for (int c : { i, j, k })
+            if (relative[c])
+                chunk.relative.emplace_back(idx_first ++);
+            else
+                ++ idx_first;
+    };
+    emit(0, 1, 2);
+    if (cnt == 4)
+        emit(0, 2, 3);
+    return true;
+}
+
+static void obj_parse_chunk(const char *begin, const char *end, ObjMeshChunk &chunk)
+{
+    for (const char *line = begin; line != end;) {
+        const char *line_end = line;
+        while (line_end != end && ! is_obj_eol(*line_end))
+            ++ line_end;
+        while (line != line_end && is_obj_whitespace(*line))
+            ++ line;
+        if (line_end - line >= 2 && is_obj_whitespace(line[1])) {
+            if (line[0] == 'v') {
+                stl_vertex v;
+                if (obj_parse_vertex(line + 2, line_end, v))
+                    chunk.vertices.emplace_back(v);
+                else
+                    ++ chunk.num_ignored;
+            } else if (line[0] == 'f') {
+                if (! obj_parse_face(line + 2, line_end, chunk)) {
+                    if (! chunk.error.empty())
+                        return;
+                    ++ chunk.num_ignored;
+                }
+            }
+        }
+        // Other lines (normals, texture coordinates, materials, groups, comments) are not needed for the mesh.
+        line = line_end;
+        while (line != end && is_obj_eol(*line))
+            ++ line;
+    }
+}
+
+bool objparse_mesh(const char *path, indexed_triangle_set &its, std::string &error)
+{
+    its.clear();
+    boost::iostreams::mapped_file_source file;
+    try {
+        boost::filesystem::path file_path(path);
+        if (boost::filesystem::file_size(file_path) == 0)
+            // Mapping an empty file fails, there is nothing to parse anyway.
+            return true;
+        file.open(file_path);
+    } catch (const std::exception &ex) {
+        error = ex.what();
+        return false;
+    }
+    if (! file.is_open()) {
+        error = "Failed to open the file.";
+        return false;
+    }
+
+    // Split the file into chunks of whole lines, which are parsed in parallel.
+    static constexpr const size_t chunk_size = 4 * 1024 * 1024;
+    const char          *data = file.data();
+    const char          *data_end = data + file.size();
+    std::vector<const char*> chunk_begins { data };
+    for (const char *p = data + chunk_size; p < data_end; p += chunk_size) {
+        p = std::find_if(p, data_end, is_obj_eol);
+        if (p == data_end)
+            break;
+        chunk_begins.emplace_back(++ p);
+    }
+    chunk_begins.emplace_back(data_end);
+
+    std::vector<ObjMeshChunk> chunks(chunk_begins.size() - 1);
+    try {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1),
+            [&chunk_begins, &chunks](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                obj_parse_chunk(chunk_begins[i], chunk_begins[i + 1], chunks[i]);
+        });
+    } catch (std::bad_alloc&) {
+        error = "Out of memory.";
+        return false;
+    }
+
+    size_t num_vertices  = 0;
+    size_t num_triangles = 0;
+    size_t num_ignored   = 0;
+    for (ObjMeshChunk &chunk : chunks) {
+        if (! chunk.error.empty()) {
+            error = std::move(chunk.error);
+            return false;
+        }
+        chunk.vertex_offset   = num_vertices;
+        chunk.triangle_offset = num_triangles;
+        num_vertices  += chunk.vertices.size();
+        num_triangles += chunk.indices.size();
+        num_ignored   += chunk.num_ignored;
+    }
+    if (num_vertices > size_t(std::numeric_limits<int>::max())) {
+        error = "The file contains too many vertices.";
+        return false;
+    }
+    if (num_ignored > 0)
+        BOOST_LOG_TRIVIAL(warning) << "ObjParser: Ignored " << num_ignored << " malformed vertex or face lines in " << path;
+
+    // Merge the chunks, resolve the relative vertex indices and validate all of them.
+    its.vertices.resize(num_vertices);
+    its.indices.resize(num_triangles);
+    std::atomic<bool> invalid_index { false };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1),
+        [&chunks, &its, &invalid_index, num_vertices](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i) {
+            ObjMeshChunk &chunk = chunks[i];
+            for (size_t idx : chunk.relative)
+                chunk.indices[idx / 3](idx % 3) += int(chunk.vertex_offset);
+            for (const stl_triangle_vertex_indices &tri : chunk.indices)
+                if (tri.minCoeff() < 0 || tri.maxCoeff() >= int(num_vertices)) {
+                    invalid_index = true;
+                    return;
+                }
+            std::copy(chunk.vertices.begin(), chunk.vertices.end(), its.vertices.begin() + chunk.vertex_offset);
+            std::copy(chunk.indices.begin(), chunk.indices.end(), its.indices.begin() + chunk.triangle_offset);
+            chunk = ObjMeshChunk();
+        }
+    });
+    if (invalid_index) {
+        its.clear();
+        error = "The file contains invalid vertex index.";
+        return false;
+    }
+    return true;
+}
+
 template<typename T> 
 bool savevector(FILE *pFile, const std::vector<T> &v)
 {
@@ -5,6 +5,8 @@
 #include <vector>
 #include <istream>
 
+struct indexed_triangle_set;
+
 namespace ObjParser {
 
 struct ObjVertex
@@ -100,6 +102,11 @@ struct ObjData {
 extern bool objparse(const char *path, ObjData &data);
 extern bool objparse(std::istream &stream, ObjData &data);
 
+// Parse just the triangle mesh of an OBJ file, skipping normals, texture coordinates, materials and groups.
+// The file is memory mapped and parsed in parallel in chunks of whole lines, quads are split into two triangles.
+// Returns false and fills in the error message on failure.
+extern bool objparse_mesh(const char *path, indexed_triangle_set &its, std::string &error);
+
 extern bool objbinsave(const char *path, const ObjData &data);
 
 extern bool objbinload(const char *path, ObjData &data);
@@ -11,7 +11,10 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <numeric>
+#include <queue>
 #include <unordered_set>
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -621,6 +624,67 @@ bool find_point_on_boundary(Point& pt_to_move, const AvoidCrossingPerimeters::Bo
     return true;
 }
 
+// Move the start and the end of a travel inside the boundary, if they are close to it.
+// Returns false if no better points were found.
+// Called by avoid_perimeters_inner() and by avoid_perimeters_visibility_graph().
+static bool move_travel_inside_boundary(const AvoidCrossingPerimeters::Boundary &boundary, Point &start, Point &end, coord_t extrusion_spacing)
+{
+    const EdgeGrid::Grid &edge_grid = boundary.grid;
+    if (!edge_grid.bbox().contains(start) || !edge_grid.bbox().contains(end) 
+        || !find_point_on_boundary(start, boundary, (extrusion_spacing * 3) / 2) 
+        || !find_point_on_boundary(end, boundary, (extrusion_spacing * 3) / 2)) {
+        //can't find one, but maybe we can find something better than nothing.
+        coordf_t dist = start.distance_to(end);
+        EdgeGrid::Grid::ClosestPointResult pt_closest_start = boundary.grid.closest_point_signed_distance(start, dist/2);
+        EdgeGrid::Grid::ClosestPointResult pt_closest_end = boundary.grid.closest_point_signed_distance(end, dist/2);
+        // Is it useful enough?
+        bool find_better = false;
+        if (pt_closest_start.distance + pt_closest_end.distance < dist / 2) {
+            const EdgeGrid::Contour& pts_start = boundary.grid.contours()[pt_closest_start.contour_idx];
+            Point new_start = pts_start.segment_start(pt_closest_start.start_point_idx).interpolate(pt_closest_start.t, pts_start.segment_end(pt_closest_start.start_point_idx));
+            const EdgeGrid::Contour& pts_end = boundary.grid.contours()[pt_closest_end.contour_idx];
+            Point new_end = pts_start.segment_start(pt_closest_end.start_point_idx).interpolate(pt_closest_end.t, pts_start.segment_end(pt_closest_end.start_point_idx));
+            // check if travel top
+            AnyIntersectionsVisitor visitor(boundary.to_avoid_grid, Polyline{start, new_start, new_end, end});
+            if(boundary.to_avoid_grid.bbox().contains(start) && boundary.to_avoid_grid.bbox().contains(new_start))
+                boundary.to_avoid_grid.visit_cells_intersecting_line(start, new_start, visitor); //TODO is this the right way to use it?
+            if(boundary.to_avoid_grid.bbox().contains(new_start) && boundary.to_avoid_grid.bbox().contains(new_end))
+                boundary.to_avoid_grid.visit_cells_intersecting_line(new_start, new_end, visitor);
+            if(boundary.to_avoid_grid.bbox().contains(new_end) && boundary.to_avoid_grid.bbox().contains(end))
+                boundary.to_avoid_grid.visit_cells_intersecting_line(new_end, end, visitor);
+            if (visitor.has_intersection) {
+                // go over avoid area, check if it's more or less than the dumb travel
+                Polylines lines = diff_pl({Polyline{start, end}}, boundary.to_avoid);
+                coordf_t old_dist_over_top = 0;
+                for(const Polyline &pl : lines)
+                    old_dist_over_top += pl.length();
+                //check if it's not obviously worse
+                if (old_dist_over_top > 0) {
+                    lines = diff_pl({Polyline{start, new_start, new_end, end}}, boundary.to_avoid);
+                    coordf_t new_dist_over_top = 0;
+                    for (const Polyline &pl : lines) new_dist_over_top += pl.length();
+                    // check if it's really better
+                    if (new_dist_over_top < old_dist_over_top / 2) {
+                        // really better!
+                        find_better = true;
+                        start = new_start;
+                        end = new_end;
+                    }
+                }
+            } else {
+                find_better = true;
+                start = new_start;
+                end = new_end;
+            }
+        }
+        if (!find_better) {
+            BOOST_LOG_TRIVIAL(debug) << "Fail to find a point in the contour for avoid_perimeter.";
+            return false;
+        }
+    }
+    return true;
+}
+
 // Called by avoid_perimeters() and by simplify_travel_heuristics().
 static size_t avoid_perimeters_inner(const AvoidCrossingPerimeters::Boundary &boundary,
                                      const Point                             &real_start,
@@ -636,60 +700,10 @@ static size_t avoid_perimeters_inner(const AvoidCrossingPerimeters::Boundary &bo
     Point end = real_end;
 
     //ensure that start & end are inside
-    if(extrusion_spacing > 0)
-        if (!edge_grid.bbox().contains(start) || !edge_grid.bbox().contains(end) 
-            || !find_point_on_boundary(start, boundary, (extrusion_spacing * 3) / 2) 
-            || !find_point_on_boundary(end, boundary, (extrusion_spacing * 3) / 2)) {
-            //can't find one, but maybe we can find something better than nothing.
-            coordf_t dist = start.distance_to(end);
-            EdgeGrid::Grid::ClosestPointResult pt_closest_start = boundary.grid.closest_point_signed_distance(start, dist/2);
-            EdgeGrid::Grid::ClosestPointResult pt_closest_end = boundary.grid.closest_point_signed_distance(end, dist/2);
-            // Is it useful enough?
-            bool find_better = false;
-            if (pt_closest_start.distance + pt_closest_end.distance < dist / 2) {
-                const EdgeGrid::Contour& pts_start = boundary.grid.contours()[pt_closest_start.contour_idx];
-                Point new_start = pts_start.segment_start(pt_closest_start.start_point_idx).interpolate(pt_closest_start.t, pts_start.segment_end(pt_closest_start.start_point_idx));
-                const EdgeGrid::Contour& pts_end = boundary.grid.contours()[pt_closest_end.contour_idx];
-                Point new_end = pts_start.segment_start(pt_closest_end.start_point_idx).interpolate(pt_closest_end.t, pts_start.segment_end(pt_closest_end.start_point_idx));
-                // check if travel top
-                AnyIntersectionsVisitor visitor(boundary.to_avoid_grid, Polyline{start, new_start, new_end, end});
-                if(boundary.to_avoid_grid.bbox().contains(start) && boundary.to_avoid_grid.bbox().contains(new_start))
-                    boundary.to_avoid_grid.visit_cells_intersecting_line(start, new_start, visitor); //TODO is this the right way to use it?
-                if(boundary.to_avoid_grid.bbox().contains(new_start) && boundary.to_avoid_grid.bbox().contains(new_end))
-                    boundary.to_avoid_grid.visit_cells_intersecting_line(new_start, new_end, visitor);
-                if(boundary.to_avoid_grid.bbox().contains(new_end) && boundary.to_avoid_grid.bbox().contains(end))
-                    boundary.to_avoid_grid.visit_cells_intersecting_line(new_end, end, visitor);
-                if (visitor.has_intersection) {
-                    // go over avoid area, check if it's more or less than the dumb travel
-                    Polylines lines = diff_pl({Polyline{start, end}}, boundary.to_avoid);
-                    coordf_t old_dist_over_top = 0;
-                    for(const Polyline &pl : lines)
-                        old_dist_over_top += pl.length();
-                    //check if it's not obviously worse
-                    if (old_dist_over_top > 0) {
-                        lines = diff_pl({Polyline{start, new_start, new_end, end}}, boundary.to_avoid);
-                        coordf_t new_dist_over_top = 0;
-                        for (const Polyline &pl : lines) new_dist_over_top += pl.length();
-                        // check if it's really better
-                        if (new_dist_over_top < old_dist_over_top / 2) {
-                            // really better!
-                            find_better = true;
-                            start = new_start;
-                            end = new_end;
-                        }
-                    }
-                } else {
-                    find_better = true;
-                    start = new_start;
-                    end = new_end;
-                }
-            }
-            if (!find_better) {
-                BOOST_LOG_TRIVIAL(debug) << "Fail to find a point in the contour for avoid_perimeter.";
-                result_out = {{start, -1}, {end, -1}};
-                return 0;
-            }
-        }
+    if (extrusion_spacing > 0 && !move_travel_inside_boundary(boundary, start, end, extrusion_spacing)) {
+        result_out = {{start, -1}, {end, -1}};
+        return 0;
+    }
 
     // Find all intersections between boundaries and the line segment, sort them along the line segment.
     std::vector<Intersection> intersections;
@@ -798,6 +812,127 @@ static size_t avoid_perimeters_inner(const AvoidCrossingPerimeters::Boundary &bo
     return intersections.size();
 }
 
+using VisibilityGraph = AvoidCrossingPerimeters::Boundary::VisibilityGraph;
+
+// Is the line from node through pt tangent to the boundary at the vertex of the node, thus could a shortest path bend there?
+// It is, if both neighbors of the vertex are on the same side of the line.
+static bool is_tangent(const VisibilityGraph::Node &node, const Vec2d &pt)
+{
+    const Vec2d dir = pt - node.vertex;
+    return cross2(dir, node.dir_prev) * cross2(dir, node.dir_next) >= 0.;
+}
+
+static bool is_visible(FirstIntersectionVisitor &visitor, const Point &pt_from, const Point &pt_to)
+{
+    if (pt_from == pt_to)
+        return true;
+    visitor.pt_current = &pt_from;
+    visitor.pt_next    = &pt_to;
+    visitor.intersect  = false;
+    visitor.grid.visit_cells_intersecting_line(pt_from, pt_to, visitor);
+    return ! visitor.intersect;
+}
+
+// Shortest path from start to end inside the boundary, searched by A* over the visibility graph.
+// Returns zero if the travel does not need to avoid anything and std::numeric_limits<size_t>::max() if no path was found,
+// otherwise the number of the vertices of boundaries, the travel bends at.
+// Called by avoid_perimeters().
+static size_t avoid_perimeters_visibility_graph(const AvoidCrossingPerimeters::Boundary &boundary,
+                                                const Point                             &real_start,
+                                                const Point                             &real_end,
+                                                      coord_t                            extrusion_spacing,
+                                                std::vector<TravelPoint>                &result_out)
+{
+    const VisibilityGraph    &graph   = boundary.visibility_graph;
+    FirstIntersectionVisitor  visitor(boundary.grid);
+
+    Point start = real_start;
+    Point end   = real_end;
+    if (extrusion_spacing > 0 && !move_travel_inside_boundary(boundary, start, end, extrusion_spacing))
+        return std::numeric_limits<size_t>::max();
+
+    std::vector<TravelPoint> result;
+    if (is_visible(visitor, start, end)) {
+        result = {{start, -1}, {end, -1}};
+    } else {
+        // The links from start to the nodes and from the nodes to end are only tested for visibility when they are popped
+        // from the queue, as most of them are never popped. The last two indices are start and end.
+        const uint32_t start_idx = uint32_t(graph.nodes.size());
+        const uint32_t end_idx   = start_idx + 1;
+        struct QueueItem {
+            // Length of the travel up to the node plus the direct distance from the node to end.
+            double   estimate;
+            double   dist;
+            uint32_t idx;
+            uint32_t idx_from;
+            bool operator<(const QueueItem &rhs) const { return estimate > rhs.estimate; }
+        };
+        std::vector<double>            dist(end_idx + 1, std::numeric_limits<double>::max());
+        std::vector<uint32_t>          prev(end_idx + 1, std::numeric_limits<uint32_t>::max());
+        std::vector<bool>              closed(end_idx + 1, false);
+        std::priority_queue<QueueItem> queue;
+        auto push = [&graph, &end, &dist, &queue, start_idx, end_idx](uint32_t idx_from, uint32_t idx, double d) {
+            if (d < dist[idx]) {
+                if (idx_from != start_idx && idx != end_idx)
+                    // Only the edges of the graph are known to be visible.
+                    dist[idx] = d;
+                queue.push({ d + (idx == end_idx ? 0. : (end - graph.nodes[idx].point).cast<double>().norm()), d, idx, idx_from });
+            }
+        };
+        const Vec2d startf = start.cast<double>();
+        const Vec2d endf   = end.cast<double>();
+        for (uint32_t idx = 0; idx < start_idx; ++ idx)
+            if (is_tangent(graph.nodes[idx], startf))
+                push(start_idx, idx, (graph.nodes[idx].point - start).cast<double>().norm());
+        while (! queue.empty()) {
+            QueueItem item = queue.top();
+            queue.pop();
+            if (closed[item.idx] ||
+                (item.idx_from == start_idx && ! is_visible(visitor, start, graph.nodes[item.idx].point)) ||
+                (item.idx == end_idx && ! is_visible(visitor, graph.nodes[item.idx_from].point, end)))
+                continue;
+            closed[item.idx] = true;
+            dist[item.idx]   = item.dist;
+            prev[item.idx]   = item.idx_from;
+            if (item.idx == end_idx)
+                break;
+            for (const std::pair<uint32_t, float> &edge : graph.edges[item.idx])
+                if (! closed[edge.first])
+                    push(item.idx, edge.first, item.dist + double(edge.second));
+            if (is_tangent(graph.nodes[item.idx], endf))
+                push(item.idx, end_idx, item.dist + (end - graph.nodes[item.idx].point).cast<double>().norm());
+        }
+        if (! closed[end_idx])
+            return std::numeric_limits<size_t>::max();
+        result.push_back({end, -1});
+        for (uint32_t idx = prev[end_idx]; idx != start_idx; idx = prev[idx])
+            result.push_back({graph.nodes[idx].point, -1});
+        result.push_back({start, -1});
+        std::reverse(result.begin(), result.end());
+    }
+
+    const size_t num_bends = result.size() - 2;
+    if (start != real_start)
+        result_out.push_back({ real_start, -1 });
+    append(result_out, std::move(result));
+    if (end != real_end)
+        result_out.push_back({ real_end, -1 });
+    return num_bends;
+}
+
+// #define AVOID_CROSSING_PERIMETERS_STATISTICS
+
+#ifdef AVOID_CROSSING_PERIMETERS_STATISTICS
+// Travel length planned with the visibility graph vs. the travel length planned by avoid_perimeters_inner(),
+// accumulated over the travels, for which the visibility graph was used.
+static struct {
+    size_t num_travels      { 0 };
+    size_t num_fallbacks    { 0 };
+    double length_graph     { 0. };
+    double length_inner     { 0. };
+} s_visibility_graph_stats;
+#endif /* AVOID_CROSSING_PERIMETERS_STATISTICS */
+
 // Called by AvoidCrossingPerimeters::travel_to()
 static size_t avoid_perimeters(const AvoidCrossingPerimeters::Boundary &boundary,
                                const Point                             &start,
@@ -808,7 +943,29 @@ static size_t avoid_perimeters(const AvoidCrossingPerimeters::Boundary &boundary
 {
     // Travel line is completely or partially inside the bounding box.
     std::vector<TravelPoint> path;
-    size_t num_intersections = avoid_perimeters_inner(boundary, start, end, spacing, layer, path);
+    size_t num_intersections = std::numeric_limits<size_t>::max();
+    if (! boundary.visibility_graph.empty())
+        num_intersections = avoid_perimeters_visibility_graph(boundary, start, end, spacing, path);
+#ifdef AVOID_CROSSING_PERIMETERS_STATISTICS
+    if (! boundary.visibility_graph.empty()) {
+        std::vector<TravelPoint> path_inner;
+        avoid_perimeters_inner(boundary, start, end, spacing, layer, path_inner);
+        const double length_inner = to_polyline(path_inner).length();
+        ++ s_visibility_graph_stats.num_travels;
+        s_visibility_graph_stats.length_inner += length_inner;
+        if (num_intersections == std::numeric_limits<size_t>::max()) {
+            // avoid_perimeters_inner() will be used for this travel.
+            ++ s_visibility_graph_stats.num_fallbacks;
+            s_visibility_graph_stats.length_graph += length_inner;
+        } else
+            s_visibility_graph_stats.length_graph += to_polyline(path).length();
+    }
+#endif /* AVOID_CROSSING_PERIMETERS_STATISTICS */
+    if (num_intersections == std::numeric_limits<size_t>::max()) {
+        // No visibility graph or the end was not reached through it.
+        path.clear();
+        num_intersections = avoid_perimeters_inner(boundary, start, end, spacing, layer, path);
+    }
     result_out = to_polyline(path);
 
 #ifdef AVOID_CROSSING_PERIMETERS_DEBUG_OUTPUT
@@ -1350,6 +1507,60 @@ static void init_boundary(AvoidCrossingPerimeters::Boundary *boundary, Polygons
     boundary->to_avoid_grid.create(to_polygons(boundary->to_avoid), coord_t(scale_(1.)));
 }
 
+// Layers with more reflex vertices do not get a visibility graph, because it is built in O(n^2).
+static constexpr size_t max_visibility_graph_nodes = 5000;
+
+// Build the reduced visibility graph of the internal boundary. Its nodes are the reflex vertices of boundaries,
+// its edges connect the nodes visible from each other, if the edge is tangent to boundaries at both its ends.
+static void init_visibility_graph(AvoidCrossingPerimeters::Boundary *boundary)
+{
+    VisibilityGraph &graph = boundary->visibility_graph;
+    graph.clear();
+    for (const Polygon &polygon : boundary->boundaries) {
+        if (polygon.size() < 3)
+            continue;
+        for (size_t point_idx = 0; point_idx < polygon.size(); ++ point_idx) {
+            const Point &vertex = polygon.points[point_idx];
+            const Point  prev   = find_first_different_vertex<false>(polygon, prev_idx_modulo(point_idx, polygon.points), vertex);
+            const Point  next   = find_first_different_vertex<true>(polygon, next_idx_modulo(point_idx, polygon.points), vertex);
+            const Vec2d  v1     = (vertex - prev).cast<double>();
+            const Vec2d  v2     = (next - vertex).cast<double>();
+            // The inside of the boundary is on the left of its polygons, a shortest path only bends at the vertices turning right.
+            if (cross2(v1, v2) < - 1e-4 * v1.norm() * v2.norm())
+                graph.nodes.push_back({ get_polygon_vertex_offset(polygon, point_idx, coord_t(SCALED_EPSILON)), vertex.cast<double>(), - v1, v2 });
+        }
+    }
+    if (graph.nodes.size() > max_visibility_graph_nodes) {
+        BOOST_LOG_TRIVIAL(debug) << "Too many reflex vertices (" << graph.nodes.size() << ") for the avoid_perimeters visibility graph.";
+        graph.clear();
+        return;
+    }
+
+    graph.edges.assign(graph.nodes.size(), {});
+    FirstIntersectionVisitor visitor(boundary->grid);
+    for (uint32_t node_idx = 0; node_idx < graph.nodes.size(); ++ node_idx) {
+        const VisibilityGraph::Node &node = graph.nodes[node_idx];
+        for (uint32_t other_idx = node_idx + 1; other_idx < graph.nodes.size(); ++ other_idx) {
+            const VisibilityGraph::Node &other = graph.nodes[other_idx];
+            if (is_tangent(node, other.vertex) && is_tangent(other, node.vertex) && is_visible(visitor, node.point, other.point)) {
+                const float length = float((other.point - node.point).cast<double>().norm());
+                graph.edges[node_idx].emplace_back(other_idx, length);
+                graph.edges[other_idx].emplace_back(node_idx, length);
+            }
+        }
+    }
+}
+
+// called by AvoidCrossingPerimeters::travel_inside()
+static void init_boundary_internal(AvoidCrossingPerimeters::Boundary *boundary, const Layer &layer, bool visibility_graph)
+{
+    std::vector<std::pair<ExPolygon, ExPolygon>> boundary_growth;
+    init_boundary(boundary, to_polygons(get_boundary(layer, boundary_growth, boundary->to_avoid)));
+    boundary->boundary_growth = std::move(boundary_growth);
+    if (visibility_graph && ! boundary->boundaries.empty())
+        init_visibility_graph(boundary);
+}
+
 // Plan travel, which avoids perimeter crossings by following the boundaries of the layer.
 Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &point, bool *could_be_wipe_disabled)
 {
@@ -1369,23 +1580,10 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
     const ExPolygons               &lslices          = gcodegen.layer()->lslices;
     const std::vector<BoundingBox> &lslices_bboxes   = gcodegen.layer()->lslices_bboxes;
     bool                            is_support_layer = dynamic_cast<const SupportLayer *>(gcodegen.layer()) != nullptr;
-    const float perimeter_spacing = get_perimeter_spacing(*gcodegen.layer());
     if (!use_external && (is_support_layer || !lslices.empty()
         /*|| (!lslices.empty() && !any_expolygon_contains(lslices, lslices_bboxes, m_grid_lslice, travel)) already done by the caller */
         )) {
-        // Initialize m_internal only when it is necessary.
-        if (m_internal.boundaries.empty()) {
-            std::vector<std::pair<ExPolygon, ExPolygon>> boundary_growth;
-            init_boundary(&m_internal, to_polygons(get_boundary(*gcodegen.layer(), boundary_growth, m_internal.to_avoid)));
-            m_internal.boundary_growth = std::move(boundary_growth);
-        }
-
-        // Trim the travel line by the bounding box.
-        if (!m_internal.boundaries.empty() && Geometry::liang_barsky_line_clipping(startf, endf, m_internal.bbox)) {
-            travel_intersection_count = avoid_perimeters(m_internal, startf.cast<coord_t>(), endf.cast<coord_t>(), perimeter_spacing, *gcodegen.layer(), result_pl);
-            result_pl.points.front()  = start;
-            result_pl.points.back()   = end;
-        }
+        result_pl = this->travel_inside(*gcodegen.layer(), start, end, gcodegen.config().avoid_crossing_perimeters_visibility_graph);
     } else if(use_external) {
         // Initialize m_external only when exist any external travel for the current layer.
         if (m_external.boundaries.empty())
@@ -1432,11 +1630,80 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
     return result_pl;
 }
 
+// Number of object layers ahead, for which the internal boundaries are computed in parallel with the visibility graph enabled.
+static constexpr size_t avoid_crossing_perimeters_lookahead_layers = 16;
+
+Polyline AvoidCrossingPerimeters::travel_inside(const Layer &layer, const Point &start, const Point &end, bool visibility_graph)
+{
+    // Initialize m_internal only when it is necessary.
+    if (m_internal_layer != &layer) {
+        if (auto it = m_internal_cache.find(&layer); it != m_internal_cache.end()) {
+            m_internal = it->second;
+        } else {
+            // Drop the boundaries of the layers already printed.
+            for (auto it = m_internal_cache.begin(); it != m_internal_cache.end();)
+                if (it->first->print_z < layer.print_z - EPSILON)
+                    it = m_internal_cache.erase(it);
+                else
+                    ++ it;
+            std::vector<const Layer*> layers { &layer };
+            if (visibility_graph) {
+                // Building the visibility graph is costly, compute the boundaries of the object and support layers
+                // of this object up to a few layers ahead in parallel.
+                const PrintObject &object = *layer.object();
+                auto layer_lower = [&layer](const auto &object_layers) {
+                    return std::lower_bound(object_layers.begin(), object_layers.end(), layer.print_z - EPSILON,
+                        [](const Layer *l, coordf_t z) { return l->print_z < z; });
+                };
+                auto     it_object = layer_lower(object.layers());
+                coordf_t max_z     = size_t(object.layers().end() - it_object) > avoid_crossing_perimeters_lookahead_layers ?
+                    (*(it_object + avoid_crossing_perimeters_lookahead_layers - 1))->print_z + EPSILON : std::numeric_limits<coordf_t>::max();
+                for (; it_object != object.layers().end() && (*it_object)->print_z < max_z; ++ it_object)
+                    if (*it_object != &layer && m_internal_cache.find(*it_object) == m_internal_cache.end())
+                        layers.emplace_back(*it_object);
+                for (auto it_support = layer_lower(object.support_layers()); it_support != object.support_layers().end() && (*it_support)->print_z < max_z; ++ it_support)
+                    if (*it_support != &layer && m_internal_cache.find(*it_support) == m_internal_cache.end())
+                        layers.emplace_back(*it_support);
+            }
+            std::vector<std::shared_ptr<Boundary>> boundaries(layers.size());
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, layers.size()),
+                [&layers, &boundaries, visibility_graph](const tbb::blocked_range<size_t> &range) {
+                    for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                        boundaries[layer_idx] = std::make_shared<Boundary>();
+                        init_boundary_internal(boundaries[layer_idx].get(), *layers[layer_idx], visibility_graph);
+                    }
+                });
+            for (size_t layer_idx = 0; layer_idx < layers.size(); ++ layer_idx)
+                m_internal_cache.emplace(layers[layer_idx], std::move(boundaries[layer_idx]));
+            m_internal = m_internal_cache[&layer];
+        }
+        m_internal_layer = &layer;
+    }
+
+    // Trim the travel line by the bounding box.
+    Polyline result_pl;
+    Vec2d    startf = start.cast<double>();
+    Vec2d    endf   = end  .cast<double>();
+    if (! m_internal->boundaries.empty() && Geometry::liang_barsky_line_clipping(startf, endf, m_internal->bbox)) {
+        avoid_perimeters(*m_internal, startf.cast<coord_t>(), endf.cast<coord_t>(), get_perimeter_spacing(layer), layer, result_pl);
+        result_pl.points.front() = start;
+        result_pl.points.back()  = end;
+    }
+    return result_pl;
+}
+
 // ************************************* AvoidCrossingPerimeters::init_layer() *****************************************
 
 void AvoidCrossingPerimeters::init_layer(const Layer &layer)
 {
-    m_internal.clear();
+#ifdef AVOID_CROSSING_PERIMETERS_STATISTICS
+    if (s_visibility_graph_stats.num_travels > 0)
+        BOOST_LOG_TRIVIAL(info) << "avoid_perimeters visibility graph: " << s_visibility_graph_stats.num_travels << " travels, " <<
+            s_visibility_graph_stats.num_fallbacks << " fallbacks, length " << unscaled(s_visibility_graph_stats.length_graph) <<
+            " mm vs. " << unscaled(s_visibility_graph_stats.length_inner) << " mm without the visibility graph";
+#endif /* AVOID_CROSSING_PERIMETERS_STATISTICS */
+
+    // The internal boundaries only depend on their layers, they are kept for the other instances of the objects.
     m_external.clear();
 
     BoundingBox bbox_slice(get_extents(layer.lslices));
@@ -5,6 +5,9 @@
 #include "../ExPolygon.hpp"
 #include "../EdgeGrid.hpp"
 
+#include <memory>
+#include <unordered_map>
+
 namespace Slic3r {
 
 // Forward declarations.
@@ -33,6 +36,9 @@ public:
     }
 
     Polyline    travel_to(const GCode& gcodegen, const Point& point, bool* could_be_wipe_disabled);
+    // Plan a travel inside the object, to which the layer belongs, in the object coordinates.
+    // Returns an empty polyline if the travel does not need to avoid any boundary of the layer.
+    Polyline    travel_inside(const Layer &layer, const Point &start, const Point &end, bool visibility_graph);
 
     struct Boundary {
         // Collection of boundaries used for detection of crossing perimeters for travels
@@ -50,12 +56,36 @@ public:
         // Used for detection of intersection between line and any polygon from to_avoid
         EdgeGrid::Grid to_avoid_grid;
 
+        // Reduced visibility graph over the reflex vertices of boundaries, used for the shortest path queries.
+        // Only built for the internal boundaries with avoid_crossing_perimeters_visibility_graph enabled.
+        struct VisibilityGraph {
+            struct Node {
+                // Vertex of boundaries moved inside by SCALED_EPSILON, the travel passes through this point.
+                Point point;
+                // The vertex and the directions to its neighbors on the polygon, for the tangency tests.
+                Vec2d vertex;
+                Vec2d dir_prev;
+                Vec2d dir_next;
+            };
+            std::vector<Node>                                    nodes;
+            // For each node, the indices of the nodes visible from it and the lengths of the edges.
+            std::vector<std::vector<std::pair<uint32_t, float>>> edges;
+
+            bool empty() const { return nodes.empty(); }
+            void clear()
+            {
+                nodes.clear();
+                edges.clear();
+            }
+        } visibility_graph;
+
         void clear()
         {
             boundaries.clear();
             boundaries_params.clear();
             boundary_growth.clear();
             to_avoid.clear();
+            visibility_graph.clear();
         }
     };
 
@@ -71,8 +101,13 @@ private:
 
     // Used for detection of line or polyline is inside of any polygon.
     EdgeGrid::Grid m_grid_lslice;
-    // Store all needed data for travels inside object
-    Boundary m_internal;
+    // Store all needed data for travels inside object, for the layer m_internal_layer.
+    std::shared_ptr<Boundary> m_internal;
+    const Layer              *m_internal_layer { nullptr };
+    // Internal boundaries of the layers printed at the current print_z and of a few layers ahead.
+    // GCode switches between the object and support layers of each instance, thus the boundaries are kept
+    // until the print moves above their layer.
+    std::unordered_map<const Layer*, std::shared_ptr<Boundary>> m_internal_cache;
     // Store all needed data for travels outside object
     Boundary m_external;
 };
@@ -737,31 +737,45 @@ MedialAxis::build(Polylines& polylines)
     polylines.insert(polylines.end(), tp.begin(), tp.end());
 }
 
+// Above this size, the diagram is built again from a simplified outline.
+static constexpr size_t max_voronoi_edges           = 20000;
+// Edges of the diagram per segment of the outline, at least (collinear segments) and usually.
+static constexpr size_t min_voronoi_edges_per_line  = 5;
+static constexpr size_t avg_voronoi_edges_per_line  = 10;
+
 void
 MedialAxis::polyline_from_voronoi(const ExPolygon& voronoi_polygon, ThickPolylines* polylines)
 {
     std::map<const VD::edge_type*, std::pair<coordf_t, coordf_t> > thickness;
     Lines lines = voronoi_polygon.lines();
     VD vd;
+    auto build_voronoi = [&lines, &vd]() -> const VD* {
+        vd.clear();
+        construct_voronoi(lines.begin(), lines.end(), &vd);
+        return &vd;
+    };
     ExPolygons poly_temp;
     const ExPolygon* poly_to_use = &voronoi_polygon;
-    construct_voronoi(lines.begin(), lines.end(), &vd);
     //use a degraded mode, so it won't slow down too much #2664
-     // first simplify from resolution, to see where we are
-    if (vd.edges().size() > 20000) {
+    // The diagram of n segments has from 5n to about 12n edges, so an outline with too many segments
+    // is simplified before the diagram is built, and the resolution of the second pass is estimated from the segments
+    // if there is no diagram to count the edges of. Only the last diagram is built then, instead of the three of them.
+    auto has_too_many_edges = [](size_t num_lines) { return num_lines * min_voronoi_edges_per_line > max_voronoi_edges; };
+    const VD* vd_ptr = has_too_many_edges(lines.size()) ? nullptr : build_voronoi();
+    // first simplify from resolution, to see where we are
+    if (vd_ptr == nullptr || vd_ptr->edges().size() > max_voronoi_edges) {
         poly_temp = poly_to_use->simplify(this->m_resolution / 2);
         if (poly_temp.size() == 1) poly_to_use = &poly_temp.front();
         lines = poly_to_use->lines();
-        vd.clear();
-        construct_voronoi(lines.begin(), lines.end(), &vd);
+        vd_ptr = has_too_many_edges(lines.size()) ? nullptr : build_voronoi();
     }
     // maybe a second one, and this time, use an adapted resolution
-    if (vd.edges().size() > 20000) {
-        poly_temp = poly_to_use->simplify(this->m_resolution * (vd.edges().size() / 40000.));
+    if (vd_ptr == nullptr || vd_ptr->edges().size() > max_voronoi_edges) {
+        const size_t num_edges = vd_ptr == nullptr ? lines.size() * avg_voronoi_edges_per_line : vd_ptr->edges().size();
+        poly_temp = poly_to_use->simplify(this->m_resolution * (num_edges / double(2 * max_voronoi_edges)));
         if (poly_temp.size() == 1) poly_to_use = &poly_temp.front();
         lines = poly_to_use->lines();
-        vd.clear();
-        construct_voronoi(lines.begin(), lines.end(), &vd);
+        build_voronoi();
     }
 
     typedef const VD::edge_type   edge_t;
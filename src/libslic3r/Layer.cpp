@@ -136,12 +136,44 @@ ExPolygons Layer::merged(float offset_scaled) const
     return out;
 }
 
+void LowerSlicesGrid::build(const ExPolygons &slices, coord_t simplify, coord_t resolution)
+{
+    this->simplify   = simplify;
+    this->resolution = resolution;
+    this->expolygons.clear();
+    //simplify the lower slices if too high (means low number) resolution (we can be very aggressive here)
+    if (simplify > 0)
+        for (const ExPolygon &expoly : slices)
+            expoly.simplify(simplify, &this->expolygons);
+    if (this->expolygons.empty())
+        this->expolygons = slices;
+    BoundingBox bbox = get_extents(this->expolygons);
+    bbox.offset(resolution);
+    bbox.align_to_grid(resolution);
+    this->grid.set_bbox(bbox);
+    this->grid.create(this->expolygons, resolution);
+    this->grid.calculate_sdf();
+}
+
+const LowerSlicesGrid& Layer::lower_slices_grid(coord_t simplify, coord_t resolution)
+{
+    assert(this->lower_layer != nullptr);
+    for (const std::unique_ptr<LowerSlicesGrid> &grid : m_lower_slices_grids)
+        if (grid->simplify == simplify && grid->resolution == resolution)
+            return *grid;
+    m_lower_slices_grids.emplace_back(std::make_unique<LowerSlicesGrid>());
+    m_lower_slices_grids.back()->build(this->lower_layer->lslices, simplify, resolution);
+    return *m_lower_slices_grids.back();
+}
+
 // Here the perimeters are created cummulatively for all layer regions sharing the same parameters influencing the perimeters.
 // The perimeter paths and the thin fills (ExtrusionEntityCollection) are assigned to the first compatible layer region.
 // The resulting fill surface is split back among the originating regions.
 void Layer::make_perimeters()
 {
     BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id();
+    // The lower slices may have changed since the last run.
+    m_lower_slices_grids.clear();
     
     // keep track of regions whose perimeters we have already generated
     std::vector<unsigned char> done(m_regions.size(), false);
@@ -264,21 +296,24 @@ void Layer::make_perimeters()
                 for (LayerRegionPtrs::iterator l = layerms.begin(); l != layerms.end(); ++l) {
                     // Separate the fill surfaces.
                     ExPolygons slices = to_expolygons((*l)->slices().surfaces);
-                    ExPolygons expp = intersection_ex(to_expolygons(fill_surfaces.surfaces), slices);
+                    ExPolygons fill_expolygons = to_expolygons(fill_surfaces.surfaces);
+                    ExPolygons expp = intersection_ex(fill_expolygons, slices);
                     (*l)->fill_expolygons = expp;
                     (*l)->fill_no_overlap_expolygons = (layerm_config)->fill_no_overlap_expolygons;
                     //(*l)->perimeters = (layerm_config)->perimeters;
                     //(*l)->thin_fills = (layerm_config)->thin_fills;
                     (*l)->fill_surfaces.clear();
-                    for (Surface &surf: fill_surfaces.surfaces) {
-                        ExPolygons exp = intersection_ex(ExPolygons{ surf.expolygon }, slices);
-                        (*l)->fill_surfaces.append(std::move(exp), surf);
-                    }
+                    // Each fill surface is clipped with the slices of its region, only with the slices overlapping it.
+                    std::vector<ExPolygons> fill_surfaces_clipped = intersection_ex_batch(fill_expolygons, slices);
+                    for (size_t i = 0; i < fill_surfaces.surfaces.size(); ++ i)
+                        (*l)->fill_surfaces.append(std::move(fill_surfaces_clipped[i]), fill_surfaces.surfaces[i]);
                 }
             }
         }
       }
     }
+    m_lower_slices_grids.clear();
+    m_lower_slices_grids.shrink_to_fit();
     BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << " - Done";
 }
 
@@ -6,6 +6,9 @@
 #include "SurfaceCollection.hpp"
 #include "ExtrusionEntityCollection.hpp"
 #include "ExPolygonCollection.hpp"
+#include "EdgeGrid.hpp"
+
+#include <memory>
 
 namespace Slic3r {
 
@@ -112,6 +115,19 @@ private:
     const PrintRegion *m_region;
 };
 
+// Slices of a layer (simplified) with a signed distance grid, queried by the overhang detection of the perimeter generator
+// of the layer above. The grid points into the expolygons, so it is neither copyable nor movable.
+struct LowerSlicesGrid
+{
+    void build(const ExPolygons &slices, coord_t simplify, coord_t resolution);
+
+    // Tolerance the slices were simplified with (0 if not simplified) and resolution of the grid.
+    coord_t         simplify   { 0 };
+    coord_t         resolution { 0 };
+    ExPolygons      expolygons;
+    EdgeGrid::Grid  grid;
+};
+
 class Layer 
 {
 public:
@@ -157,6 +173,10 @@ public:
     // Slices merged into islands, to be used by the elephant foot compensation to trim the individual surfaces with the shrunk merged slices.
     ExPolygons              merged(float offset) const;
     void                    make_perimeters();
+    // Grid of the lower layer slices for the overhang detection, built once for each (simplify, resolution) pair
+    // and shared by the perimeter generators of all regions of this layer. Only valid while generating the perimeters,
+    // the regions of a layer are processed sequentially, thus there is no locking.
+    const LowerSlicesGrid&  lower_slices_grid(coord_t simplify, coord_t resolution);
     void                    make_milling_post_process();
     // Phony version of make_fills() without parameters for Perl integration only.
     void                    make_fills() { this->make_fills(nullptr, nullptr, nullptr); }
@@ -189,6 +209,8 @@ private:
     size_t              m_id;
     PrintObject        *m_object;
     LayerRegionPtrs     m_regions;
+    // Cache of lower_slices_grid(), released by make_perimeters() once all the regions are processed.
+    std::vector<std::unique_ptr<LowerSlicesGrid>> m_lower_slices_grids;
 };
 
 class SupportLayer : public Layer 
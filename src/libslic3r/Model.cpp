@@ -17,6 +17,7 @@
 #include "Format/STL.hpp"
 #include "Format/3mf.hpp"
 #include "Format/STEP.hpp"
+#include "Format/MeshCache.hpp"
 
 #include <float.h>
 
@@ -137,8 +138,14 @@ Model Model::read_from_file(const std::string& input_file, DynamicPrintConfig* c
     if (config_substitutions == nullptr)
         config_substitutions = &temp_config_substitutions_context;
 
+    // Geometry only files may be loaded from the opt-in mesh cache, skipping parsing and repair.
+    const bool use_mesh_cache = ! mesh_cache_dir().empty() && is_mesh_cache_supported(input_file);
+    bool loaded_from_cache = use_mesh_cache && load_mesh_cache(input_file.c_str(), &model);
+
     bool result = false;
-    if (boost::algorithm::iends_with(input_file, ".stl"))
+    if (loaded_from_cache)
+        result = true;
+    else if (boost::algorithm::iends_with(input_file, ".stl"))
         result = load_stl(input_file.c_str(), &model);
     else if (boost::algorithm::iends_with(input_file, ".obj"))
         result = load_obj(input_file.c_str(), &model);
@@ -157,6 +164,9 @@ Model Model::read_from_file(const std::string& input_file, DynamicPrintConfig* c
 
     if (model.objects.empty())
         throw Slic3r::RuntimeError("The supplied file couldn't be read because it's empty");
+
+    if (use_mesh_cache && ! loaded_from_cache)
+        store_mesh_cache(input_file.c_str(), model);
     
     for (ModelObject *o : model.objects)
         o->input_file = input_file;
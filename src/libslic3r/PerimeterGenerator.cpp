@@ -30,6 +30,8 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 //#define ARACHNE_DEBUG
 
 #ifdef ARACHNE_DEBUG
@@ -150,18 +152,6 @@ static void fuzzy_extrusion_line(Arachne::ExtrusionLine &ext_lines, double fuzzy
         ext_lines.junctions = std::move(out);
 }
 
-void convert_to_clipperpath(const Polygons& source, ClipperLib_Z::Paths& dest) {
-    dest.clear();
-    dest.reserve(source.size());
-    for (const Polygon& poly : source) {
-        dest.emplace_back();
-        ClipperLib_Z::Path& out = dest.back();
-        out.reserve(poly.points.size());
-        for (const Point& pt : poly.points)
-            out.emplace_back(pt.x(), pt.y(), 0);
-    }
-}
-
 #ifdef ARACHNE_DEBUG
 static void export_perimeters_to_svg(const std::string &path, const Polygons &contours, const std::vector<Arachne::VariableWidthLines> &perimeters, const ExPolygons &infill_area)
 {
@@ -482,7 +472,7 @@ ProcessSurfaceResult PerimeterGenerator::process_arachne(int& loop_number, const
         this->throw_if_canceled();
     if (ExtrusionEntityCollection extrusion_coll = _traverse_extrusions(ordered_extrusions); !extrusion_coll.empty()) {
         extrusion_coll.set_can_sort_reverse(false, false);
-        this->loops->append(extrusion_coll);
+        result.loops.append(extrusion_coll);
     }
 
     ExPolygons    infill_contour = union_ex(wallToolPaths.getInnerContour());
@@ -713,33 +703,33 @@ void PerimeterGenerator::process()
             }
         }
 
-        if (overhangs_width_speed > 0 || overhangs_width_flow > 0) {
-            ExPolygons simplified;
-            //simplify the lower slices if too high (means low number) resolution (we can be very aggressive here)
-            if (this->print_config->resolution < min_feature / 2) {
-                for (const ExPolygon& expoly : *lower_slices) {
-                    expoly.simplify(min_feature, &simplified);
-                }
-            }
-
+        if ((overhangs_width_speed > 0 || overhangs_width_flow > 0) && ! this->lower_slices->empty()) {
+            // Instead of growing the lower slices by each overhang width and clipping the perimeters with them,
+            // the perimeters are split by their signed distance from the lower slices, see create_overhangs().
+            auto add_threshold = [this](coord_t overhangs_width, int kind) {
+                this->_overhang_thresholds.emplace_back(coordf_t(overhangs_width) - coordf_t(this->ext_perimeter_width / 2));
+                this->_overhang_kinds.emplace_back(kind);
+            };
             if (overhangs_width_speed > 0 && (overhangs_width_speed < overhangs_width_flow || overhangs_width_flow == 0)) {
-                this->_lower_slices_bridge_speed_small = offset((simplified.empty() ? *this->lower_slices : simplified), (coordf_t)overhangs_width_speed_90 - (coordf_t)(ext_perimeter_width / 2));
-                this->_lower_slices_bridge_speed_big = offset((simplified.empty() ? *this->lower_slices : simplified), (coordf_t)overhangs_width_speed_110 - (coordf_t)(ext_perimeter_width / 2));
-                if (use_arachne) {
-                    convert_to_clipperpath(this->_lower_slices_bridge_speed_small, this->_lower_slices_bridge_speed_small_clipperpaths);
-                    convert_to_clipperpath(this->_lower_slices_bridge_speed_big, this->_lower_slices_bridge_speed_big_clipperpaths);
-                }
+                add_threshold(overhangs_width_speed_90, 1);
+                add_threshold(overhangs_width_speed_110, 2);
             }
             if (overhangs_width_flow > 0) {
-                if (overhangs_width_speed_110 == overhangs_width_flow_90 && overhangs_width_speed < overhangs_width_flow) {
-                    this->_lower_slices_bridge_flow_small = this->_lower_slices_bridge_speed_big;
-                    if (use_arachne) this->_lower_slices_bridge_flow_small_clipperpaths = this->_lower_slices_bridge_speed_big_clipperpaths;
+                add_threshold(overhangs_width_flow_90, 3);
+                add_threshold(overhangs_width_flow_110, 4);
+            }
+            if (! this->_overhang_thresholds.empty()) {
+                // The grid cells are as large as the search radius of the distance queries.
+                coordf_t max_threshold = std::max(std::abs(this->_overhang_thresholds.front()), std::abs(this->_overhang_thresholds.back()));
+                coord_t  resolution    = std::max(coord_t(max_threshold) + ext_perimeter_width, coord_t(scale_(0.5)));
+                coord_t  simplify      = this->print_config->resolution < min_feature / 2 ? min_feature : 0;
+                if (this->layer != nullptr && this->layer->lower_layer != nullptr && this->lower_slices == &this->layer->lower_layer->lslices) {
+                    this->_lower_slices_grid = &this->layer->lower_slices_grid(simplify, resolution);
                 } else {
-                    this->_lower_slices_bridge_flow_small = offset((simplified.empty() ? *this->lower_slices : simplified), (coordf_t)overhangs_width_flow_90 - (coordf_t)(ext_perimeter_width / 2));
-                    if (use_arachne) convert_to_clipperpath(this->_lower_slices_bridge_flow_small, this->_lower_slices_bridge_flow_small_clipperpaths);
+                    this->_lower_slices_grid_owned = std::make_unique<LowerSlicesGrid>();
+                    this->_lower_slices_grid_owned->build(*this->lower_slices, simplify, resolution);
+                    this->_lower_slices_grid = this->_lower_slices_grid_owned.get();
                 }
-                this->_lower_slices_bridge_flow_big = offset((simplified.empty() ? *this->lower_slices : simplified), (coordf_t)overhangs_width_flow_110 - (coordf_t)(ext_perimeter_width / 2));
-                if (use_arachne) convert_to_clipperpath(this->_lower_slices_bridge_flow_big, this->_lower_slices_bridge_flow_big_clipperpaths);
             }
         }
     }
@@ -762,135 +752,148 @@ void PerimeterGenerator::process()
 
     processs_no_bridge(all_surfaces);
 
-    int surface_idx = 0;
+    // The islands are processed in parallel, as a flat layer may have hundreds of them. Each island writes its extrusions
+    // and infill areas into its own result, the results are merged in the order of the islands.
+    std::vector<ProcessSurfaceResult> surface_results(all_surfaces.size());
     const int extra_odd_perimeter = (config->extra_perimeters_odd_layers && layer->id() % 2 == 1 ? 1 : 0);
-    for (const Surface& surface : all_surfaces) {
-        // detect how many perimeters must be generated for this island
-        int        loop_number = this->config->perimeters + surface.extra_perimeters - 1 + extra_odd_perimeter;  // 0-indexed loops
-        surface_idx++;
-
-        if (print_config->spiral_vase) {
-            if (layer->id() >= config->bottom_solid_layers) {
-                loop_number = 0;
-            }
-        }
-
-        if ((layer->id() == 0 && this->config->only_one_perimeter_first_layer) || (this->config->only_one_perimeter_top && loop_number > 0 && this->upper_slices == NULL)) {
-            loop_number = 0;
-        }
-
-        ProcessSurfaceResult surface_process_result;
-        //core generation
-        if (use_arachne) {
-            surface_process_result = process_arachne(loop_number, surface);
-        } else {
-            surface_process_result = process_classic(loop_number, surface);
-        }
-        this->throw_if_canceled();
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, all_surfaces.size(), 1),
+        [this, &all_surfaces, &surface_results, extra_odd_perimeter](const tbb::blocked_range<size_t>& range) {
+            for (size_t surface_idx = range.begin(); surface_idx < range.end(); ++ surface_idx) {
+                const Surface &surface = all_surfaces[surface_idx];
+                // detect how many perimeters must be generated for this island
+                int        loop_number = this->config->perimeters + surface.extra_perimeters - 1 + extra_odd_perimeter;  // 0-indexed loops
+
+                if (print_config->spiral_vase) {
+                    if (layer->id() >= config->bottom_solid_layers) {
+                        loop_number = 0;
+                    }
+                }
 
+                if ((layer->id() == 0 && this->config->only_one_perimeter_first_layer) || (this->config->only_one_perimeter_top && loop_number > 0 && this->upper_slices == NULL)) {
+                    loop_number = 0;
+                }
 
-        // create one more offset to be used as boundary for fill
-        // we offset by half the perimeter spacing (to get to the actual infill boundary)
-        // and then we offset back and forth by half the infill spacing to only consider the
-        // non-collapsing regions
-        coord_t inset = 0;
-        coord_t infill_peri_overlap = 0;
-        // only apply infill overlap if we actually have one perimeter
-        if (loop_number >= 0) {
-            // half infill / perimeter
-            inset = (loop_number == 0) ?
-                // one loop
-                this->get_ext_perimeter_spacing() / 2 :
-                // two or more loops?
-                this->get_perimeter_spacing() / 2;
-            //infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", unscale<coordf_t>(perimeter_spacing + solid_infill_spacing) / 2));
-            //give the overlap size to let the infill do his overlap
-            //add overlap if at least one perimeter
-            coordf_t perimeter_spacing_for_encroach = 0;
-            if(this->config->perimeters == 1)
-                perimeter_spacing_for_encroach = this->ext_perimeter_flow.spacing();
-            else if(this->config->only_one_perimeter_top.value)
-                //note: use the min of the two to avoid overextrusion if only one perimeter top
-                // TODO: only do that if there is a top & a not-top surface
-                perimeter_spacing_for_encroach = std::min(this->perimeter_flow.spacing(), this->ext_perimeter_flow.spacing());
-            else //if(layerm->region().config().perimeters > 1)
-                perimeter_spacing_for_encroach = this->perimeter_flow.spacing();
-            infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", perimeter_spacing_for_encroach));
-        }
-
-        //remove gapfill from last
-        ExPolygons last_no_gaps = (surface_process_result.gap_srf.empty()) ? surface_process_result.inner_perimeter : diff_ex(surface_process_result.inner_perimeter, surface_process_result.gap_srf);
-
-        // simplify infill contours according to resolution
-        Polygons not_filled_p;
-        for (ExPolygon& ex : last_no_gaps)
-            ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
-        ExPolygons not_filled_exp = union_ex(not_filled_p);
-        // collapse too narrow infill areas
-        coord_t min_perimeter_infill_spacing = (coord_t)(this->get_solid_infill_spacing() * (1. - INSET_OVERLAP_TOLERANCE));
-        ExPolygons infill_exp;
-        //special branch if gap : don't inset away from gaps!
-        if (surface_process_result.gap_srf.empty()) {
-            infill_exp = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(min_perimeter_infill_spacing / 2));
-        } else {
-            //store the infill_exp but not offseted, it will be used as a clip to remove the gapfill portion
-            const ExPolygons infill_exp_no_gap = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(inset + min_perimeter_infill_spacing / 2 - infill_peri_overlap + this->get_infill_gap()));
-            //redo the same as not_filled_exp but with last instead of last_no_gaps
-            not_filled_p.clear();
-            for (ExPolygon& ex : surface_process_result.inner_perimeter)
-                ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
-            not_filled_exp = union_ex(not_filled_p);
-            infill_exp = offset2_ex(not_filled_exp,
-                double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
-                double(min_perimeter_infill_spacing / 2));
-            // intersect(growth(surface_process_result.inner_perimeter-gap) , surface_process_result.inner_perimeter), so you have the (surface_process_result.inner_perimeter - small gap) but without voids betweeng gap & surface_process_result.inner_perimeter
-            infill_exp = intersection_ex(infill_exp, infill_exp_no_gap);
-        }
+                ProcessSurfaceResult &surface_process_result = surface_results[surface_idx];
+                //core generation
+                if (use_arachne) {
+                    surface_process_result = process_arachne(loop_number, surface);
+                } else {
+                    surface_process_result = process_classic(loop_number, surface);
+                }
+                this->throw_if_canceled();
+
+
+                // create one more offset to be used as boundary for fill
+                // we offset by half the perimeter spacing (to get to the actual infill boundary)
+                // and then we offset back and forth by half the infill spacing to only consider the
+                // non-collapsing regions
+                coord_t inset = 0;
+                coord_t infill_peri_overlap = 0;
+                // only apply infill overlap if we actually have one perimeter
+                if (loop_number >= 0) {
+                    // half infill / perimeter
+                    inset = (loop_number == 0) ?
+                        // one loop
+                        this->get_ext_perimeter_spacing() / 2 :
+                        // two or more loops?
+                        this->get_perimeter_spacing() / 2;
+                    //infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", unscale<coordf_t>(perimeter_spacing + solid_infill_spacing) / 2));
+                    //give the overlap size to let the infill do his overlap
+                    //add overlap if at least one perimeter
+                    coordf_t perimeter_spacing_for_encroach = 0;
+                    if(this->config->perimeters == 1)
+                        perimeter_spacing_for_encroach = this->ext_perimeter_flow.spacing();
+                    else if(this->config->only_one_perimeter_top.value)
+                        //note: use the min of the two to avoid overextrusion if only one perimeter top
+                        // TODO: only do that if there is a top & a not-top surface
+                        perimeter_spacing_for_encroach = std::min(this->perimeter_flow.spacing(), this->ext_perimeter_flow.spacing());
+                    else //if(layerm->region().config().perimeters > 1)
+                        perimeter_spacing_for_encroach = this->perimeter_flow.spacing();
+                    infill_peri_overlap = scale_t(this->config->get_abs_value("infill_overlap", perimeter_spacing_for_encroach));
+                }
+
+                //remove gapfill from last
+                ExPolygons last_no_gaps = (surface_process_result.gap_srf.empty()) ? surface_process_result.inner_perimeter : diff_ex(surface_process_result.inner_perimeter, surface_process_result.gap_srf);
+
+                // simplify infill contours according to resolution
+                Polygons not_filled_p;
+                for (ExPolygon& ex : last_no_gaps)
+                    ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
+                ExPolygons not_filled_exp = union_ex(not_filled_p);
+                // collapse too narrow infill areas
+                coord_t min_perimeter_infill_spacing = (coord_t)(this->get_solid_infill_spacing() * (1. - INSET_OVERLAP_TOLERANCE));
+                ExPolygons infill_exp;
+                //special branch if gap : don't inset away from gaps!
+                if (surface_process_result.gap_srf.empty()) {
+                    infill_exp = offset2_ex(not_filled_exp,
+                        double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+                        double(min_perimeter_infill_spacing / 2));
+                } else {
+                    //store the infill_exp but not offseted, it will be used as a clip to remove the gapfill portion
+                    const ExPolygons infill_exp_no_gap = offset2_ex(not_filled_exp,
+                        double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+                        double(inset + min_perimeter_infill_spacing / 2 - infill_peri_overlap + this->get_infill_gap()));
+                    //redo the same as not_filled_exp but with last instead of last_no_gaps
+                    not_filled_p.clear();
+                    for (ExPolygon& ex : surface_process_result.inner_perimeter)
+                        ex.simplify_p(scale_t(std::max(this->print_config->resolution.value, print_config->resolution_internal / 4)), &not_filled_p);
+                    not_filled_exp = union_ex(not_filled_p);
+                    infill_exp = offset2_ex(not_filled_exp,
+                        double(-inset - min_perimeter_infill_spacing / 2 + infill_peri_overlap - this->get_infill_gap()),
+                        double(min_perimeter_infill_spacing / 2));
+                    // intersect(growth(surface_process_result.inner_perimeter-gap) , surface_process_result.inner_perimeter), so you have the (surface_process_result.inner_perimeter - small gap) but without voids betweeng gap & surface_process_result.inner_perimeter
+                    infill_exp = intersection_ex(infill_exp, infill_exp_no_gap);
+                }
         
-        this->throw_if_canceled();
-        //if any top_fills, grow them by ext_perimeter_spacing/2 to have the real un-anchored fill
-        ExPolygons top_infill_exp = intersection_ex(surface_process_result.fill_clip, offset_ex(surface_process_result.top_fills, double(this->get_ext_perimeter_spacing() / 2)));
-        if (!surface_process_result.top_fills.empty()) {
-            infill_exp = union_ex(infill_exp, offset_ex(top_infill_exp, double(infill_peri_overlap)));
-        }
-        // append infill areas to fill_surfaces
-        this->fill_surfaces->append(infill_exp, stPosInternal | stDensSparse);
-
-        if (infill_peri_overlap != 0) {
-            ExPolygons polyWithoutOverlap;
-            if (min_perimeter_infill_spacing / 2 > infill_peri_overlap)
-                polyWithoutOverlap = offset2_ex(
-                    not_filled_exp,
-                    double(-inset - infill_gap - min_perimeter_infill_spacing / 2 + infill_peri_overlap),
-                    double(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
-            else
-                polyWithoutOverlap = offset_ex(
-                    not_filled_exp,
-                    double(-inset - this->get_infill_gap()));
-            if (!surface_process_result.top_fills.empty()) {
-                polyWithoutOverlap = union_ex(polyWithoutOverlap, top_infill_exp);
-            }
-            this->fill_no_overlap.insert(this->fill_no_overlap.end(), polyWithoutOverlap.begin(), polyWithoutOverlap.end());
-            /*{
-                static int isaqsdsdfsdfqzfn = 0;
-                std::stringstream stri;
-                stri << this->layer->id() << "_2_end_makeperimeter_" << isaqsdsdfsdfqzfn++ << ".svg";
-                SVG svg(stri.str());
-                svg.draw(to_polylines(infill_exp), "blue");
-                svg.draw(to_polylines(fill_no_overlap), "cyan");
-                svg.draw(to_polylines(not_filled_exp), "green");
-                svg.draw(to_polylines(last_no_gaps), "yellow");
-                //svg.draw(to_polylines(offset_ex(surface_process_result.fill_clip, ext_perimeter_spacing / 2)), "brown");
-                svg.draw(to_polylines(top_infill_exp), "orange");
-                svg.Close();
-            }*/
-        }
-    }
+                this->throw_if_canceled();
+                //if any top_fills, grow them by ext_perimeter_spacing/2 to have the real un-anchored fill
+                ExPolygons top_infill_exp = intersection_ex(surface_process_result.fill_clip, offset_ex(surface_process_result.top_fills, double(this->get_ext_perimeter_spacing() / 2)));
+                if (!surface_process_result.top_fills.empty()) {
+                    infill_exp = union_ex(infill_exp, offset_ex(top_infill_exp, double(infill_peri_overlap)));
+                }
+                // append infill areas to fill_surfaces
+                surface_process_result.infill = std::move(infill_exp);
+
+                if (infill_peri_overlap != 0) {
+                    ExPolygons polyWithoutOverlap;
+                    if (min_perimeter_infill_spacing / 2 > infill_peri_overlap)
+                        polyWithoutOverlap = offset2_ex(
+                            not_filled_exp,
+                            double(-inset - infill_gap - min_perimeter_infill_spacing / 2 + infill_peri_overlap),
+                            double(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
+                    else
+                        polyWithoutOverlap = offset_ex(
+                            not_filled_exp,
+                            double(-inset - this->get_infill_gap()));
+                    if (!surface_process_result.top_fills.empty()) {
+                        polyWithoutOverlap = union_ex(polyWithoutOverlap, top_infill_exp);
+                    }
+                    surface_process_result.fill_no_overlap = std::move(polyWithoutOverlap);
+                    /*{
+                        static int isaqsdsdfsdfqzfn = 0;
+                        std::stringstream stri;
+                        stri << this->layer->id() << "_2_end_makeperimeter_" << isaqsdsdfsdfqzfn++ << ".svg";
+                        SVG svg(stri.str());
+                        svg.draw(to_polylines(infill_exp), "blue");
+                        svg.draw(to_polylines(fill_no_overlap), "cyan");
+                        svg.draw(to_polylines(not_filled_exp), "green");
+                        svg.draw(to_polylines(last_no_gaps), "yellow");
+                        //svg.draw(to_polylines(offset_ex(surface_process_result.fill_clip, ext_perimeter_spacing / 2)), "brown");
+                        svg.draw(to_polylines(top_infill_exp), "orange");
+                        svg.Close();
+                    }*/
+                }
+            }
+        });
+    this->throw_if_canceled();
 
+    for (ProcessSurfaceResult &surface_result : surface_results) {
+        this->loops->append_move_from(surface_result.loops);
+        this->gap_fill->append_move_from(surface_result.gap_fill);
+        this->fill_surfaces->append(std::move(surface_result.infill), stPosInternal | stDensSparse);
+        append(this->fill_no_overlap, std::move(surface_result.fill_no_overlap));
+    }
 }
 
 void PerimeterGenerator::processs_no_bridge(Surfaces& all_surfaces) {
@@ -1665,11 +1668,11 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
         // append perimeters for this slice as a collection
         if (!peri_entities.empty()) {
             //move it, to avoid to clone evrything and then delete it
-            this->loops->append(peri_entities);
+            results.loops.append(peri_entities);
         }
     } // for each loop of an island
 #if _DEBUG
-    this->loops->visit(LoopAssertVisitor{});
+    results.loops.visit(LoopAssertVisitor{});
 #endif
 
     // fill gaps
@@ -1765,7 +1768,7 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
         // create extrusion from lines
         Flow gap_fill_flow = Flow::new_from_width(this->perimeter_flow.width(), this->perimeter_flow.nozzle_diameter(),this->perimeter_flow.height(), this->config->gap_fill_overlap.get_abs_value(1.), false);
         if (!polylines.empty()) {
-            this->gap_fill->append(Geometry::thin_variable_width(
+            results.gap_fill.append(Geometry::thin_variable_width(
                 polylines,
                 erGapFill, 
                 gap_fill_flow, 
@@ -1778,7 +1781,7 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
                 that medial axis skips but infill might join with other infill regions
                 and use zigzag).  */
                 // get clean surface of gap
-            results.gap_srf = union_ex(offset(this->gap_fill->polygons_covered_by_width(float(SCALED_EPSILON) / 10), float(SCALED_EPSILON / 2)));
+            results.gap_srf = union_ex(offset(results.gap_fill.polygons_covered_by_width(float(SCALED_EPSILON) / 10), float(SCALED_EPSILON / 2)));
             // intersection to ignore the bits of gapfill tha may be over infill, as it's epsilon and there may be some voids here anyway.
             results.gap_srf = intersection_ex(results.gap_srf, gaps_ex);
             // the diff(last, gap) will be done after, as we have to keep the last un-gapped to avoid unneeded gap/infill offset
@@ -1791,6 +1794,118 @@ ProcessSurfaceResult PerimeterGenerator::process_classic(int& loop_number, const
 }
 
 
+// Split a path into pieces of the same overhang level, where the level of a point is the number of thresholds
+// (sorted in ascending order) exceeded by the signed distance of the point from the lower slices.
+// The signed distance is 1-Lipschitz, thus the walk may jump by the distance to the nearest threshold without missing
+// any crossing. Crossings closer than min_step to each other may be missed. The crossings are then refined by bisection.
+template<typename PointType>
+static std::vector<std::pair<std::vector<PointType>, size_t>> split_by_overhang_level(
+    const std::vector<PointType> &path, const EdgeGrid::Grid &grid, const std::vector<coordf_t> &thresholds, coord_t min_step)
+{
+    using Scalar = typename PointType::Scalar;
+    assert(! thresholds.empty() && std::is_sorted(thresholds.begin(), thresholds.end()));
+    const coord_t search_radius = coord_t(std::max(std::abs(thresholds.front()), std::abs(thresholds.back()))) + 2 * min_step;
+    const BoundingBox &grid_bbox = grid.bbox();
+    auto signed_distance = [&grid, &grid_bbox, search_radius](const PointType &pt) -> coordf_t {
+        Point p(coord_t(pt.x()), coord_t(pt.y()));
+        if (! grid_bbox.contains(p))
+            return coordf_t(search_radius);
+        coordf_t dist;
+        if (grid.signed_distance_edges(p, search_radius, dist))
+            return dist;
+        // Farther than search_radius from the lower slices, only the side matters.
+        return grid.signed_distance_bilinear(p) > 0 ? coordf_t(search_radius) : - coordf_t(search_radius);
+    };
+    auto level = [&thresholds](coordf_t dist) {
+        return size_t(std::upper_bound(thresholds.begin(), thresholds.end(), dist, std::less_equal<coordf_t>()) - thresholds.begin());
+    };
+    auto interpolate = [](const PointType &a, const PointType &b, double t) {
+        PointType out = a;
+        for (int i = 0; i < int(a.size()); ++ i)
+            out(i) = a(i) + Scalar(std::round(double(b(i) - a(i)) * t));
+        return out;
+    };
+
+    std::vector<std::pair<std::vector<PointType>, size_t>> out;
+    std::vector<PointType> piece { path.front() };
+    coordf_t dist_prev  = signed_distance(path.front());
+    size_t   level_prev = level(dist_prev);
+    auto append = [&piece](const PointType &pt) {
+        if (piece.back().x() != pt.x() || piece.back().y() != pt.y())
+            piece.emplace_back(pt);
+    };
+    for (size_t i = 1; i < path.size(); ++ i) {
+        const PointType &a = path[i - 1];
+        const PointType &b = path[i];
+        const double len = (Vec2d(double(b.x()), double(b.y())) - Vec2d(double(a.x()), double(a.y()))).norm();
+        if (len == 0)
+            continue;
+        double t_prev = 0;
+        while (t_prev < 1.) {
+            // Distance to the nearest threshold is the longest step, which cannot skip a crossing.
+            coordf_t step = std::numeric_limits<coordf_t>::max();
+            if (level_prev > 0)
+                step = dist_prev - thresholds[level_prev - 1];
+            if (level_prev < thresholds.size())
+                step = std::min(step, thresholds[level_prev] - dist_prev);
+            step = std::max(step, coordf_t(min_step));
+            double   t     = std::min(1., t_prev + step / len);
+            coordf_t dist  = signed_distance(interpolate(a, b, t));
+            size_t   lvl   = level(dist);
+            while (lvl != level_prev) {
+                // Bisect the crossing of the threshold separating level_prev from its neighbor towards lvl.
+                const bool     up        = lvl > level_prev;
+                const coordf_t threshold = thresholds[up ? level_prev : level_prev - 1];
+                double t_lo = t_prev;
+                double t_hi = t;
+                while ((t_hi - t_lo) * len > SCALED_EPSILON) {
+                    double t_mid = 0.5 * (t_lo + t_hi);
+                    if ((signed_distance(interpolate(a, b, t_mid)) > threshold) == up)
+                        t_hi = t_mid;
+                    else
+                        t_lo = t_mid;
+                }
+                PointType split = interpolate(a, b, t_hi);
+                append(split);
+                if (piece.size() > 1)
+                    out.emplace_back(std::move(piece), level_prev);
+                piece = { split };
+                level_prev = up ? level_prev + 1 : level_prev - 1;
+                t_prev     = t_hi;
+            }
+            t_prev    = t;
+            dist_prev = dist;
+        }
+        append(b);
+    }
+    if (piece.size() > 1)
+        out.emplace_back(std::move(piece), level_prev);
+    return out;
+}
+
+std::vector<std::pair<Polyline, size_t>> split_by_overhang_level(
+    const Polyline &perimeter, const EdgeGrid::Grid &lower_slices_grid, const std::vector<coordf_t> &thresholds, coord_t min_step)
+{
+    std::vector<std::pair<Polyline, size_t>> out;
+    for (auto &[points, level] : split_by_overhang_level(perimeter.points, lower_slices_grid, thresholds, min_step))
+        out.emplace_back(Polyline(std::move(points)), level);
+    return out;
+}
+
+// Are the bridge speed big and bridge flow small overhangs sharing the same threshold? Then there are no bridge speed big overhangs.
+bool PerimeterGenerator::overhang_no_small_flow() const
+{
+    auto it_speed_big = std::find(this->_overhang_kinds.begin(), this->_overhang_kinds.end(), 2);
+    auto it_flow_small = std::find(this->_overhang_kinds.begin(), this->_overhang_kinds.end(), 3);
+    return it_speed_big != this->_overhang_kinds.end() && it_flow_small != this->_overhang_kinds.end() &&
+        this->_overhang_thresholds[it_speed_big - this->_overhang_kinds.begin()] == this->_overhang_thresholds[it_flow_small - this->_overhang_kinds.begin()];
+}
+
+coord_t PerimeterGenerator::overhang_min_step() const
+{
+    return std::max(coord_t(SCALED_EPSILON), scale_t(this->print_config->resolution));
+}
+
 ExtrusionPaths PerimeterGenerator::create_overhangs(const Polyline& loop_polygons, ExtrusionRole role, bool is_external) const {
     ExtrusionPaths paths;
     const double overhangs_width = this->config->overhangs_width.get_abs_value(this->overhang_flow.nozzle_diameter());
@@ -1810,92 +1925,25 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const Polyline& loop_polygon
     
     }
     //set the fan & speed before the flow
-    Polylines ok_polylines = { loop_polygons };
-
+    Polylines ok_polylines;
     Polylines small_speed;
     Polylines big_speed;
-    bool no_small_flow = _lower_slices_bridge_speed_big == _lower_slices_bridge_flow_small;
+    bool no_small_flow = this->overhang_no_small_flow();
     Polylines small_flow;
     Polylines big_flow;
-#ifdef _DEBUG
-    for (Polyline& poly : ok_polylines)
-        for (int i = 0; i < poly.points.size() - 1; i++)
-            assert(poly.points[i] != poly.points[i + 1]);
-#endif
-
-    Polylines* previous = &ok_polylines;
-    if (overhangs_width_speed > 0 && (overhangs_width_speed < overhangs_width || overhangs_width == 0)) {
-        if (!this->_lower_slices_bridge_speed_small.empty()) {
-            small_speed = diff_pl(*previous, this->_lower_slices_bridge_speed_small);
-#ifdef _DEBUG
-            for (Polyline& poly : small_speed) //                       assert small_speed
-                for (int i = 0; i < poly.points.size() - 1; i++) //     assert small_speed
-                    assert(poly.points[i] != poly.points[i + 1]); //    assert small_speed
-#endif
-            if (!small_speed.empty()) {
-                *previous = intersection_pl(*previous, this->_lower_slices_bridge_speed_small);
-#ifdef _DEBUG
-                for (Polyline& poly : *previous) //                         assert previous
-                    for (int i = 0; i < poly.points.size() - 1; i++) //     assert previous
-                        assert(poly.points[i] != poly.points[i + 1]); //    assert previous
-#endif
-                previous = &small_speed;
-            }
-        }
-        if (!this->_lower_slices_bridge_speed_big.empty()) {
-            big_speed = diff_pl(*previous, this->_lower_slices_bridge_speed_big);
-#ifdef _DEBUG
-            for (Polyline& poly : big_speed) //                         assert big_speed
-                for (int i = 0; i < poly.points.size() - 1; i++) //     assert big_speed
-                    assert(poly.points[i] != poly.points[i + 1]); //    assert big_speed
-#endif
-            if (!big_speed.empty()) {
-                *previous = intersection_pl(*previous, this->_lower_slices_bridge_speed_big);
-#ifdef _DEBUG
-                for (Polyline& poly : *previous) //                         assert previous
-                    for (int i = 0; i < poly.points.size() - 1; i++) //     assert previous
-                        assert(poly.points[i] != poly.points[i + 1]); //    assert previous
-#endif
-                previous = &big_speed;
-            }
-        }
+    if (this->_overhang_thresholds.empty()) {
+        ok_polylines = { loop_polygons };
+    } else {
+        Polylines *by_kind[5] = { &ok_polylines, &small_speed, &big_speed, &small_flow, &big_flow };
+        for (auto &[points, level] : split_by_overhang_level(loop_polygons.points, this->_lower_slices_grid->grid, this->_overhang_thresholds, this->overhang_min_step()))
+            by_kind[level == 0 ? 0 : this->_overhang_kinds[level - 1]]->emplace_back(std::move(points));
     }
-    if (overhangs_width > 0) {
-        if (!this->_lower_slices_bridge_flow_small.empty()) {
-            small_flow = diff_pl(*previous, this->_lower_slices_bridge_flow_small);
-#ifdef _DEBUG
-            for (Polyline& poly : small_flow) //                        assert small_flow
-                for (int i = 0; i < poly.points.size() - 1; i++) //     assert small_flow
-                    assert(poly.points[i] != poly.points[i + 1]); //    assert small_flow
-#endif
-            if (!small_flow.empty()) {
-                *previous = intersection_pl(*previous, this->_lower_slices_bridge_flow_small);
-#ifdef _DEBUG
-                for (Polyline& poly : *previous) //                         assert previous
-                    for (int i = 0; i < poly.points.size() - 1; i++) //     assert previous
-                        assert(poly.points[i] != poly.points[i + 1]); //    assert previous
-#endif
-                previous = &small_flow;
-            }
-        }
-        if (!this->_lower_slices_bridge_flow_big.empty()) {
-            big_flow = diff_pl(*previous, this->_lower_slices_bridge_flow_big);
 #ifdef _DEBUG
-            for (Polyline& poly : big_flow) //                          assert big_flow
-                for (int i = 0; i < poly.points.size() - 1; i++) //     assert big_flow
-                    assert(poly.points[i] != poly.points[i + 1]); //    assert big_flow
+    for (Polylines *polylines : { &ok_polylines, &small_speed, &big_speed, &small_flow, &big_flow })
+        for (Polyline& poly : *polylines)
+            for (int i = 0; i < poly.points.size() - 1; i++)
+                assert(poly.points[i] != poly.points[i + 1]);
 #endif
-            if (!big_flow.empty()) {
-                *previous = intersection_pl(*previous, this->_lower_slices_bridge_flow_big);
-#ifdef _DEBUG
-                for (Polyline& poly : *previous) //                         assert previous
-                    for (int i = 0; i < poly.points.size() - 1; i++) //     assert previous
-                        assert(poly.points[i] != poly.points[i + 1]); //    assert previous
-#endif
-                previous = &big_flow;
-            }
-        }
-    }
 
     //note: layer height is used to identify the path type
     if (!ok_polylines.empty()) {
@@ -2091,59 +2139,6 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const Polyline& loop_polygon
     return paths;
 }
 
-#ifdef _DEBUG
-void test_overhangs(const std::vector<ClipperLib_Z::Path>& path1, const std::vector<ClipperLib_Z::Path>& path2, Points &outer_points)
-{
-    for (const ClipperLib_Z::Path &poly : path1)
-        for (int i = 0; i < poly.size() - 1; i++)
-            assert(poly[i] != poly[i + 1]);
-    for (const ClipperLib_Z::Path &poly : path2)
-        for (int i = 0; i < poly.size() - 1; i++)
-            assert(poly[i] != poly[i + 1]);
-    // check if points are equal
-    //Points path2_points;
-    //Points path1_points;
-    //for (auto &line : path2)
-    //    for (auto &pt : line) path2_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
-    //for (auto &line : path1)
-    //    for (auto &pt : line) path1_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
-    //for (Point &pt : path2_points) {
-    //    bool found    = false;
-    //    bool in_outer = false;
-    //    Point pt2_almost;
-    //    for (Point &pt2 : path1_points)
-    //        if (pt.coincides_with_epsilon(pt2)) {
-    //            found = true;
-    //            pt2_almost = pt2;
-    //            break;
-    //        }
-    //    for (Point &pt2 : outer_points)
-    //        if (pt.coincides_with_epsilon(pt2)) {
-    //            found    = true;
-    //            in_outer = true;
-    //            pt2_almost = pt2;
-    //            break;
-    //        }
-    //    assert(found);
-    //    found    = false;
-    //    in_outer = false;
-    //    for (Point &pt2 : path1_points)
-    //        if (pt.coincides_with(pt2)) {
-    //            found = true;
-    //            break;
-    //        }
-    //    for (Point &pt2 : outer_points)
-    //        if (pt.coincides_with(pt2)) {
-    //            found    = true;
-    //            in_outer = true;
-    //            break;
-    //        }
-    //    assert(found);
-    //}
-    //  => points can be different from diff & intersect
-    // TODO: create a new operation that create the diff & intersect at the same time
-}
-#endif
 
 //TODO: transform to ExtrusionMultiPath instead of ExtrusionPaths
 ExtrusionPaths PerimeterGenerator::create_overhangs(const ClipperLib_Z::Path& arachne_path, ExtrusionRole role, bool is_external) const {
@@ -2170,105 +2165,26 @@ ExtrusionPaths PerimeterGenerator::create_overhangs(const ClipperLib_Z::Path& ar
 
     }
     //set the fan & speed before the flow
-    ClipperLib_Z::Paths ok_polylines = { arachne_path };
-
+    ClipperLib_Z::Paths ok_polylines;
     ClipperLib_Z::Paths small_speed;
     ClipperLib_Z::Paths big_speed;
-    bool no_small_flow = _lower_slices_bridge_speed_big_clipperpaths == _lower_slices_bridge_flow_small_clipperpaths;
+    bool no_small_flow = this->overhang_no_small_flow();
     ClipperLib_Z::Paths small_flow;
     ClipperLib_Z::Paths big_flow;
-#ifdef _DEBUG
-    for (ClipperLib_Z::Path& poly : ok_polylines)
-        for (int i = 0; i < poly.size() - 1; i++)
-            assert(poly[i] != poly[i + 1]);
-#endif
-
-    std::vector<ClipperLib_Z::Path>* previous = &ok_polylines;
-    if (overhangs_width_speed > 0 && (overhangs_width_speed < overhangs_width || overhangs_width == 0)) {
-        if (!this->_lower_slices_bridge_speed_small_clipperpaths.empty()) {
-            //small_speed = diff_pl(*previous, this->_lower_slices_bridge_speed_small);
-#ifdef _DEBUG
-            Points outer_points;
-            for(auto & line: *previous) for(auto &pt : line) outer_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
-#endif
-            small_speed = clip_extrusion(*previous, this->_lower_slices_bridge_speed_small_clipperpaths, ClipperLib_Z::ctDifference);
-#ifdef _DEBUG
-            for (ClipperLib_Z::Path& poly : small_speed) //                       assert small_speed
-                for (int i = 0; i < poly.size() - 1; i++) //     assert small_speed
-                    assert(poly[i] != poly[i + 1]); //    assert small_speed
-#endif
-            if (!small_speed.empty()) {
-                *previous = clip_extrusion(*previous, this->_lower_slices_bridge_speed_small_clipperpaths, ClipperLib_Z::ctIntersection);
-#ifdef _DEBUG
-                test_overhangs(small_speed, *previous, outer_points);
-                test_overhangs(*previous, small_speed, outer_points);
-#endif
-                previous = &small_speed;
-            }
-        }
-        if (!this->_lower_slices_bridge_speed_big.empty()) {
-#ifdef _DEBUG
-            Points outer_points;
-            for(auto & line: *previous) for(auto &pt : line) outer_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
-#endif
-            big_speed = clip_extrusion(*previous, this->_lower_slices_bridge_speed_big_clipperpaths, ClipperLib_Z::ctDifference);
-#ifdef _DEBUG
-            for (ClipperLib_Z::Path& poly : big_speed) //                         assert big_speed
-                for (int i = 0; i < poly.size() - 1; i++) //     assert big_speed
-                    assert(poly[i] != poly[i + 1]); //    assert big_speed
-#endif
-            if (!big_speed.empty()) {
-                *previous = clip_extrusion(*previous, this->_lower_slices_bridge_speed_big_clipperpaths, ClipperLib_Z::ctIntersection);
-#ifdef _DEBUG
-                test_overhangs(big_speed, *previous, outer_points);
-                test_overhangs(*previous, big_speed, outer_points);
-#endif
-                previous = &big_speed;
-            }
-        }
+    if (this->_overhang_thresholds.empty()) {
+        ok_polylines = { arachne_path };
+    } else {
+        // The extrusion width stored in Z is interpolated at the splitting points.
+        ClipperLib_Z::Paths *by_kind[5] = { &ok_polylines, &small_speed, &big_speed, &small_flow, &big_flow };
+        for (auto &[path, level] : split_by_overhang_level(arachne_path, this->_lower_slices_grid->grid, this->_overhang_thresholds, this->overhang_min_step()))
+            by_kind[level == 0 ? 0 : this->_overhang_kinds[level - 1]]->emplace_back(std::move(path));
     }
-    if (overhangs_width > 0) {
-        if (!this->_lower_slices_bridge_flow_small.empty()) {
 #ifdef _DEBUG
-            Points outer_points;
-            for(auto & line: *previous) for(auto &pt : line) outer_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
+    for (ClipperLib_Z::Paths *polylines : { &ok_polylines, &small_speed, &big_speed, &small_flow, &big_flow })
+        for (ClipperLib_Z::Path& poly : *polylines)
+            for (int i = 0; i < poly.size() - 1; i++)
+                assert(poly[i] != poly[i + 1]);
 #endif
-            small_flow = clip_extrusion(*previous, this->_lower_slices_bridge_flow_small_clipperpaths, ClipperLib_Z::ctDifference);
-#ifdef _DEBUG
-            for (ClipperLib_Z::Path& poly : small_flow) //                        assert small_flow
-                for (int i = 0; i < poly.size() - 1; i++) //     assert small_flow
-                    assert(poly[i] != poly[i + 1]); //    assert small_flow
-#endif
-            if (!small_flow.empty()) {
-                *previous = clip_extrusion(*previous, this->_lower_slices_bridge_flow_small_clipperpaths, ClipperLib_Z::ctIntersection);
-#ifdef _DEBUG
-                test_overhangs(small_flow, *previous, outer_points);
-                test_overhangs(*previous, small_flow, outer_points);
-#endif
-                previous = &small_flow;
-            }
-        }
-        if (!this->_lower_slices_bridge_flow_big.empty()) {
-#ifdef _DEBUG
-            Points outer_points;
-            for(auto & line: *previous) for(auto &pt : line) outer_points.emplace_back(coord_t(pt.x()), coord_t(pt.y()));
-#endif
-            big_flow = clip_extrusion(*previous, this->_lower_slices_bridge_flow_big_clipperpaths, ClipperLib_Z::ctDifference);
-#ifdef _DEBUG
-            for (ClipperLib_Z::Path& poly : big_flow) //                          assert big_flow
-                for (int i = 0; i < poly.size() - 1; i++) //     assert big_flow
-                    assert(poly[i] != poly[i + 1]); //    assert big_flow
-#endif
-            if (!big_flow.empty()) {
-                *previous = clip_extrusion(*previous, this->_lower_slices_bridge_flow_big_clipperpaths, ClipperLib_Z::ctIntersection);
-#ifdef _DEBUG
-                test_overhangs(big_flow, *previous, outer_points);
-                test_overhangs(*previous, big_flow, outer_points);
-#endif
-                previous = &big_flow;
-            }
-        }
-    }
 
     //note: layer height is used to identify the path type
     if (!ok_polylines.empty()) {
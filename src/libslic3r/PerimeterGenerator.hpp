@@ -3,6 +3,7 @@
 
 #include "libslic3r.h"
 #include <vector>
+#include "EdgeGrid.hpp"
 #include "ExPolygonCollection.hpp"
 #include "Flow.hpp"
 #include "Layer.hpp"
@@ -69,6 +70,11 @@ struct ProcessSurfaceResult {
     ExPolygons gap_srf;
     ExPolygons top_fills;
     ExPolygons fill_clip;
+    // output of the island, merged into loops, gap_fill, fill_surfaces and fill_no_overlap of the PerimeterGenerator
+    ExtrusionEntityCollection loops;
+    ExtrusionEntityCollection gap_fill;
+    ExPolygons infill;
+    ExPolygons fill_no_overlap;
 };
 
 class PerimeterGenerator {
@@ -130,15 +136,14 @@ private:
     double      m_ext_mm3_per_mm;
     double      m_mm3_per_mm;
     double      m_mm3_per_mm_overhang;
-    Polygons    _lower_slices_bridge_flow_small;
-    Polygons    _lower_slices_bridge_flow_big;
-    Polygons    _lower_slices_bridge_speed_small;
-    Polygons    _lower_slices_bridge_speed_big;
-    ClipperLib_Z::Paths m_lower_slices_clipperpaths;
-    ClipperLib_Z::Paths _lower_slices_bridge_flow_small_clipperpaths;
-    ClipperLib_Z::Paths _lower_slices_bridge_flow_big_clipperpaths;
-    ClipperLib_Z::Paths _lower_slices_bridge_speed_small_clipperpaths;
-    ClipperLib_Z::Paths _lower_slices_bridge_speed_big_clipperpaths;
+    // Lower slices (simplified) with a grid for the signed distance queries of the overhang detection.
+    // Shared by all the regions of the layer (see Layer::lower_slices_grid()), or owned if lower_slices are not the lower layer's.
+    const LowerSlicesGrid           *_lower_slices_grid = nullptr;
+    std::unique_ptr<LowerSlicesGrid> _lower_slices_grid_owned;
+    // Signed distances from the lower slices, beyond which a perimeter is an overhang, in ascending order.
+    // Kind of each of them: 1 - bridge speed small, 2 - bridge speed big, 3 - bridge flow small, 4 - bridge flow big.
+    std::vector<coordf_t> _overhang_thresholds;
+    std::vector<int>      _overhang_kinds;
 
     //process data
     coord_t perimeter_width; coord_t get_perimeter_width() { return perimeter_width; }
@@ -159,6 +164,8 @@ private:
     void        processs_no_bridge(Surfaces& all_surfaces);
     ExtrusionPaths create_overhangs(const Polyline& loop_polygons, ExtrusionRole role, bool is_external) const;
     ExtrusionPaths create_overhangs(const ClipperLib_Z::Path& loop_polygons, ExtrusionRole role, bool is_external) const;
+    bool           overhang_no_small_flow() const;
+    coord_t        overhang_min_step() const;
 
     // transform loops into ExtrusionEntityCollection, adding also thin walls into it.
     ExtrusionEntityCollection _traverse_loops(const PerimeterGeneratorLoops &loops, ThickPolylines &thin_walls, int count_since_overhang = -1) const;
@@ -181,7 +188,11 @@ private:
 
 };
 
-
+// Split a perimeter into pieces of the same overhang level. The level of a point is the number of thresholds (in ascending order)
+// exceeded by the signed distance of the point from the lower slices, which are stored in lower_slices_grid.
+// This is how PerimeterGenerator::create_overhangs() classifies the perimeters.
+std::vector<std::pair<Polyline, size_t>> split_by_overhang_level(
+    const Polyline &perimeter, const EdgeGrid::Grid &lower_slices_grid, const std::vector<coordf_t> &thresholds, coord_t min_step);
 
 }
 
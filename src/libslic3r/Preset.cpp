@@ -518,6 +518,7 @@ static std::vector<std::string> s_Preset_print_options {
         "only_retract_when_crossing_perimeters", "enforce_retract_first_layer",
         "infill_first",
         "avoid_crossing_perimeters_max_detour",
+        "avoid_crossing_perimeters_visibility_graph",
         "max_volumetric_extrusion_rate_slope_positive", "max_volumetric_extrusion_rate_slope_negative", 
         "min_width_top_surface",
         // speeds
@@ -608,6 +609,7 @@ static std::vector<std::string> s_Preset_print_options {
         "support_material_layer_height", "support_material_interface_layer_height",
         "support_material_pattern", "support_material_with_sheath", "support_material_spacing",
         "support_material_closing_radius", "support_material_style",
+        "support_tree_angle", "support_tree_branch_diameter", "support_tree_branch_diameter_angle", "support_tree_tip_diameter",
         "support_material_synchronize_layers",
         "support_material_angle",
         "support_material_angle_height",
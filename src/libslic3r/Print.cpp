@@ -66,6 +66,7 @@ bool Print::invalidate_state_by_config_options(const ConfigOptionResolver& /* ne
     static std::unordered_set<std::string> steps_gcode = {
         "avoid_crossing_perimeters",
         "avoid_crossing_perimeters_max_detour",
+        "avoid_crossing_perimeters_visibility_graph",
         "avoid_crossing_not_first_layer",
         "avoid_crossing_top",
         "bed_shape",
@@ -187,7 +187,8 @@ CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(SupportMaterialPattern)
 
 static const t_config_enum_values s_keys_map_SupportMaterialStyle {
     { "grid",           smsGrid },
-    { "snug",           smsSnug }
+    { "snug",           smsSnug },
+    { "tree",           smsTree }
 };
 CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(SupportMaterialStyle)
 
@@ -633,6 +634,15 @@ void PrintConfigDef::init_fff_params()
     def->mode = comExpert | comPrusa;
     def->set_default_value(new ConfigOptionFloatOrPercent(0., false));
 
+    def = this->add("avoid_crossing_perimeters_visibility_graph", coBool);
+    def->label = L("Avoid crossing perimeters - Shortest paths");
+    def->category = OptionCategory::perimeter;
+    def->tooltip = L("Plan the travels of avoid crossing perimeters as the shortest paths around the holes and the concave corners "
+                     "of the layer, instead of following the perimeters. The paths are searched in a graph, which is computed "
+                     "for all the layers in parallel before the G-code export. It needs more memory.");
+    def->mode = comExpert | comSuSi;
+    def->set_default_value(new ConfigOptionBool(false));
+
     def = this->add("avoid_crossing_top", coBool);
     def->label = L("Avoid top surface for travels");
     def->category = OptionCategory::perimeter;
@@ -5670,15 +5680,62 @@ void PrintConfigDef::init_fff_params()
     def->category = OptionCategory::support;
     def->tooltip = L("Style and shape of the support towers. Projecting the supports into a regular grid "
         "will create more stable supports, while snug support towers will save material and reduce "
-        "object scarring.");
+        "object scarring. Tree supports grow branches from the supported areas down to the print bed, "
+        "merging them on the way, which saves even more material on organic shapes.");
     def->enum_keys_map = &ConfigOptionEnum<SupportMaterialStyle>::get_enum_values();
     def->enum_values.push_back("grid");
     def->enum_values.push_back("snug");
+    def->enum_values.push_back("tree");
     def->enum_labels.push_back(L("Grid"));
     def->enum_labels.push_back(L("Snug"));
+    def->enum_labels.push_back(L("Tree"));
     def->mode = comAdvancedE | comPrusa;
     def->set_default_value(new ConfigOptionEnum<SupportMaterialStyle>(smsGrid));
 
+    def = this->add("support_tree_angle", coFloat);
+    def->label = L("Maximum branch angle");
+    def->full_label = L("Tree support maximum branch angle");
+    def->category = OptionCategory::support;
+    def->tooltip = L("The maximum angle of the branches of the tree supports from the vertical. "
+        "Use a higher angle to let the branches reach further and merge sooner, at the cost of stability.");
+    def->sidetext = L("°");
+    def->min = 0;
+    def->max = 85;
+    def->mode = comAdvancedE | comPrusa;
+    def->set_default_value(new ConfigOptionFloat(40));
+
+    def = this->add("support_tree_branch_diameter", coFloat);
+    def->label = L("Branch diameter");
+    def->full_label = L("Tree support branch diameter");
+    def->category = OptionCategory::support;
+    def->tooltip = L("The diameter of the thinnest branches of the tree supports, below their tips.");
+    def->sidetext = L("mm");
+    def->min = 0;
+    def->mode = comAdvancedE | comPrusa;
+    def->set_default_value(new ConfigOptionFloat(2));
+
+    def = this->add("support_tree_branch_diameter_angle", coFloat);
+    def->label = L("Branch diameter angle");
+    def->full_label = L("Tree support branch diameter angle");
+    def->category = OptionCategory::support;
+    def->tooltip = L("The angle of the cone, by which the branches of the tree supports gradually thicken towards the bottom. "
+        "Zero keeps the branches at their diameter all the way down.");
+    def->sidetext = L("°");
+    def->min = 0;
+    def->max = 15;
+    def->mode = comExpert | comPrusa;
+    def->set_default_value(new ConfigOptionFloat(5));
+
+    def = this->add("support_tree_tip_diameter", coFloat);
+    def->label = L("Tip diameter");
+    def->full_label = L("Tree support tip diameter");
+    def->category = OptionCategory::support;
+    def->tooltip = L("The diameter of the tips of the branches of the tree supports.");
+    def->sidetext = L("mm");
+    def->min = 0;
+    def->mode = comExpert | comPrusa;
+    def->set_default_value(new ConfigOptionFloat(0.8));
+
     def = this->add("support_material_synchronize_layers", coBool);
     def->label = L("Synchronize with object layers");
     def->category = OptionCategory::support;
@@ -8092,6 +8149,7 @@ std::unordered_set<std::string> prusa_export_to_remove_keys = {
 "arc_fitting",
 "arc_fitting_tolerance",
 "avoid_crossing_not_first_layer",
+"avoid_crossing_perimeters_visibility_graph",
 "avoid_crossing_top",
 "bridge_fill_pattern",
 "bridge_internal_acceleration",
@@ -9722,6 +9780,26 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->label = L("Data directory");
     def->tooltip = L("Load and store settings at the given directory. This is useful for maintaining different profiles or including configurations from a network storage.");
 
+    def = this->add("mesh_cache", coString);
+    def->label = L("Mesh cache directory");
+    def->tooltip = L("Cache the repaired meshes of the loaded STL, OBJ and STEP files in the given directory. "
+                     "Loading the same file again reads the meshes from the cache instead of parsing and repairing them. "
+                     "This is useful when slicing the same models repeatedly with different profiles.");
+
+    def = this->add("step_linear_deflection", coFloat);
+    def->label = L("STEP linear deflection");
+    def->tooltip = L("Maximum distance of the triangles from the surfaces of the imported STEP solids. "
+                     "Lower values produce finer and larger meshes. Default is 0.005 mm.");
+    def->sidetext = L("mm");
+    def->min = 0;
+
+    def = this->add("step_angular_deflection", coFloat);
+    def->label = L("STEP angular deflection");
+    def->tooltip = L("Maximum angle between the normals of adjacent triangles of the imported STEP solids. "
+                     "Lower values produce finer and larger meshes. Default is 1 radian.");
+    def->sidetext = L("radians");
+    def->min = 0;
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Sets logging sensitivity. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n"
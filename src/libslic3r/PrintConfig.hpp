@@ -151,6 +151,7 @@ enum SupportMaterialPattern {
 enum SupportMaterialStyle {
     smsGrid,
     smsSnug,
+    smsTree,
 };
 
 //from prusa, not used in superslicer as InfillPattern is enough.
@@ -804,6 +805,11 @@ PRINT_CONFIG_CLASS_DEFINE(
     ((ConfigOptionInt,                  support_material_threshold))
     ((ConfigOptionBool,                 support_material_with_sheath))
     ((ConfigOptionFloatOrPercent,       support_material_xy_spacing))
+    // Tree supports only.
+    ((ConfigOptionFloat,                support_tree_angle))
+    ((ConfigOptionFloat,                support_tree_branch_diameter))
+    ((ConfigOptionFloat,                support_tree_branch_diameter_angle))
+    ((ConfigOptionFloat,                support_tree_tip_diameter))
     ((ConfigOptionBool,                 thin_walls_merge))
     ((ConfigOptionFloat,                xy_size_compensation))
     ((ConfigOptionFloat,                xy_inner_size_compensation))
@@ -1161,6 +1167,7 @@ PRINT_CONFIG_CLASS_DERIVED_DEFINE(
     ((ConfigOptionBool,                 avoid_crossing_perimeters))
     ((ConfigOptionBool,                 avoid_crossing_not_first_layer))    
     ((ConfigOptionFloatOrPercent,       avoid_crossing_perimeters_max_detour))
+    ((ConfigOptionBool,                 avoid_crossing_perimeters_visibility_graph))
     ((ConfigOptionPoints,               bed_shape))
     ((ConfigOptionInts,                 bed_temperature))
     ((ConfigOptionFloatOrPercent,       bridge_acceleration))
@@ -25,6 +25,7 @@
 #include <boost/log/trivial.hpp>
 
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
 
 #include <Shiny/Shiny.h>
 
@@ -766,9 +767,12 @@ namespace Slic3r {
         for (size_t i = 1; i < overhangs.size(); ++i)
             append(overhangs.front(), std::move(overhangs[i]));
 
-        return std::make_pair(
-            adaptive_line_spacing ? build_octree(mesh, overhangs.front(), adaptive_line_spacing, false) : OctreePtr(),
-            support_line_spacing ? build_octree(mesh, overhangs.front(), support_line_spacing, true) : OctreePtr());
+        // The two octrees are independent, build them in parallel.
+        std::pair<OctreePtr, OctreePtr> octrees;
+        tbb::parallel_invoke(
+            [&]() { if (adaptive_line_spacing) octrees.first = build_octree(mesh, overhangs.front(), adaptive_line_spacing, false); },
+            [&]() { if (support_line_spacing) octrees.second = build_octree(mesh, overhangs.front(), support_line_spacing, true); });
+        return octrees;
     }
 
 FillLightning::GeneratorPtr PrintObject::prepare_lightning_infill_data()
@@ -955,7 +959,11 @@ bool PrintObject::invalidate_state_by_config_options(
                 || opt_key == "support_material_closing_radius"
                 || opt_key == "support_material_synchronize_layers"
                 || opt_key == "support_material_threshold"
-                || opt_key == "support_material_with_sheath") {
+                || opt_key == "support_material_with_sheath"
+                || opt_key == "support_tree_angle"
+                || opt_key == "support_tree_branch_diameter"
+                || opt_key == "support_tree_branch_diameter_angle"
+                || opt_key == "support_tree_tip_diameter") {
                 steps.emplace_back(posSupportMaterial);
             } else if (opt_key == "bottom_solid_layers") {
                 steps.emplace_back(posPrepareInfill);
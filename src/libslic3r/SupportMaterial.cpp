@@ -8,6 +8,7 @@
 #include "Flow.hpp"
 #include "Point.hpp"
 #include "MutablePolygon.hpp"
+#include "TreeSupport.hpp"
 
 #include <cmath>
 #include <memory>
@@ -16,9 +17,18 @@
 #include <boost/log/trivial.hpp>
 #include <boost/container/static_vector.hpp>
 
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/spin_mutex.h>
 #include <tbb/task_group.h>
+#include <tbb/version.h>
+#if TBB_VERSION_MAJOR >= 2021
+    #include <tbb/parallel_pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter_mode;
+#else
+    #include <tbb/pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter;
+#endif
 #pragma optimize("", off)
 #define SUPPORT_USE_AGG_RASTERIZER
 
@@ -181,9 +191,10 @@ void export_print_z_polygons_and_extrusions_to_svg(
 #endif /* SLIC3R_DEBUG */
 
 #ifdef SUPPORT_USE_AGG_RASTERIZER
-static std::vector<unsigned char> rasterize_polygons(const Vec2i32 &grid_size, const double pixel_size, const Point &left_bottom, const Polygons &polygons)
+// Rasterize into a buffer reused by the caller. The buffer is resized to the grid and cleared.
+static void rasterize_polygons(const Vec2i32 &grid_size, const double pixel_size, const Point &left_bottom, const Polygons &polygons, std::vector<unsigned char> &data)
 {
-    std::vector<unsigned char>                  data(grid_size.x() * grid_size.y());
+    data.resize(size_t(grid_size.x()) * size_t(grid_size.y()));
     agg::rendering_buffer                       rendering_buffer(data.data(), unsigned(grid_size.x()), unsigned(grid_size.y()), grid_size.x());
     agg::pixfmt_gray8                           pixel_renderer(rendering_buffer);
     agg::renderer_base<agg::pixfmt_gray8>       raw_renderer(pixel_renderer);
@@ -212,19 +223,27 @@ static std::vector<unsigned char> rasterize_polygons(const Vec2i32 &grid_size, c
         rasterizer.add_path(std::move(path));
     }
     agg::render_scanlines(rasterizer, scanline, renderer);
+}
+
+static std::vector<unsigned char> rasterize_polygons(const Vec2i32 &grid_size, const double pixel_size, const Point &left_bottom, const Polygons &polygons)
+{
+    std::vector<unsigned char> data;
+    rasterize_polygons(grid_size, pixel_size, left_bottom, polygons, data);
     return data;
 }
+
 // Grid has to have the boundary pixels unset.
-static Polygons contours_simplified(const Vec2i32 &grid_size, const double pixel_size, Point left_bottom, const std::vector<unsigned char> &grid, coord_t offset, bool fill_holes)
+// cell_inside_data is a temporary buffer reused by the caller.
+static Polygons contours_simplified(const Vec2i32 &grid_size, const double pixel_size, Point left_bottom, const std::vector<unsigned char> &grid, coord_t offset, bool fill_holes,
+    std::vector<unsigned char> &cell_inside_data)
 {
     assert(std::abs(2 * offset) < pixel_size - 10);
 
     // Fill in empty cells, which have a left / right neighbor filled.
     // Fill in empty cells, which have the top / bottom neighbor filled.
-    std::vector<unsigned char>        cell_inside_data;
     const std::vector<unsigned char> &cell_inside = fill_holes ? cell_inside_data : grid;
     if (fill_holes) {
-        cell_inside_data = grid;
+        cell_inside_data.assign(grid.begin(), grid.end());
         for (int r = 1; r + 1 < grid_size.y(); ++ r) {
             for (int c = 1; c + 1 < grid_size.x(); ++ c) {
                 int addr = r * grid_size.x() + c;
@@ -422,7 +441,8 @@ PrintObjectSupportMaterial::PrintObjectSupportMaterial(const PrintObject *object
     }
 
     SupportMaterialPattern  support_pattern = m_object_config->support_material_pattern;
-    m_support_params.with_sheath            = m_object_config->support_material_with_sheath;
+    // The thin branches of the tree supports are printed with their outlines.
+    m_support_params.with_sheath            = m_object_config->support_material_with_sheath || m_object_config->support_material_style.value == smsTree;
     m_support_params.base_fill_pattern      = 
         support_pattern == smpHoneycomb ? ipHoneycomb :
         m_support_params.support_density > 0.95 || m_support_params.with_sheath ? ipRectilinear : ipSupportBase;
@@ -514,9 +534,18 @@ void PrintObjectSupportMaterial::generate(PrintObject &object)
     // layer_support_areas contains the per object layer support areas. These per object layer support areas
     // may get merged and trimmed by this->generate_base_layers() if the support layers are not synchronized with object layers.
     std::vector<Polygons> layer_support_areas;
-    MyLayersPtr bottom_contacts = this->bottom_contact_layers_and_layer_support_areas(
-        object, top_contacts, buildplate_covered,
-        layer_storage, layer_support_areas);
+    MyLayersPtr bottom_contacts;
+    if (m_object_config->support_material_style.value == smsTree) {
+        // The support areas are the cross sections of branches grown from the top contacts down to the print bed.
+        // The branches, which could not avoid the object, stand on its top surfaces over bottom contacts.
+        std::vector<Polygons> branch_landings;
+        layer_support_areas = tree_support_layer_support_areas(object, top_contacts, buildplate_covered,
+            TreeSupportParams(*m_object_config, m_support_params.support_spacing, m_support_params.gap_xy), branch_landings);
+        bottom_contacts = this->tree_bottom_contact_layers(object, top_contacts, branch_landings, layer_storage, layer_support_areas);
+    } else
+        bottom_contacts = this->bottom_contact_layers_and_layer_support_areas(
+            object, top_contacts, buildplate_covered,
+            layer_storage, layer_support_areas);
 
 #ifdef SLIC3R_DEBUG
     for (size_t layer_id = 0; layer_id < object.layers().size(); ++ layer_id)
@@ -764,15 +793,29 @@ Polygons collect_slices_outer(const Layer &layer)
     return out;
 }
 
+// Temporary rasters of the support grid, reused by the following layers instead of being allocated
+// and released for each SupportGridPattern. One set per thread, owned by a single step of the support generator,
+// so that the buffers are released once the step finishes.
+struct SupportRasterBuffers
+{
+    std::vector<unsigned char> trimming;
+    std::vector<unsigned char> trimming_dilated;
+    std::vector<uint64_t>      trimming_bits;
+    std::vector<unsigned char> cell_inside;
+};
+using SupportRasterBuffersPerThread = tbb::enumerable_thread_specific<SupportRasterBuffers>;
+
 struct SupportGridParams {
-    SupportGridParams(const PrintObjectConfig &object_config, const Flow &support_material_flow) :
-        style(object_config.support_material_style.value),
+    SupportGridParams(const PrintObjectConfig &object_config, const Flow &support_material_flow, SupportRasterBuffersPerThread &raster_buffers) :
+        // The contact areas of the tree supports are shaped the snug way.
+        style(object_config.support_material_style.value == smsTree ? smsSnug : object_config.support_material_style.value),
         grid_resolution(object_config.support_material_spacing.value + support_material_flow.spacing()),
         support_angle(Geometry::deg2rad(object_config.support_material_angle.value)),
         extrusion_width(support_material_flow.spacing()),
         support_material_closing_radius(object_config.support_material_closing_radius.value),
         expansion_to_slice(coord_t(support_material_flow.scaled_spacing() / 2 + 5)),
-        expansion_to_propagate(-3) {}
+        expansion_to_propagate(-3),
+        raster_buffers(&raster_buffers) {}
 
     SupportMaterialStyle    style;
     double                  grid_resolution;
@@ -781,6 +824,7 @@ struct SupportGridParams {
     double                  support_material_closing_radius;
     coord_t                 expansion_to_slice;
     coord_t                 expansion_to_propagate;
+    SupportRasterBuffersPerThread *raster_buffers;
 };
 
 class SupportGridPattern
@@ -796,7 +840,8 @@ public:
         m_support_polygons(support_polygons), m_trimming_polygons(trimming_polygons),
         m_support_spacing(params.grid_resolution), m_support_angle(params.support_angle),
         m_extrusion_width(params.extrusion_width),
-        m_support_material_closing_radius(params.support_material_closing_radius)
+        m_support_material_closing_radius(params.support_material_closing_radius),
+        m_raster_buffers(params.raster_buffers)
     {
         switch (m_style) {
         case smsGrid:
@@ -839,9 +884,10 @@ public:
             assert(m_grid_size.y() >= grid_size_raw.y());
             m_grid2 = rasterize_polygons(m_grid_size, m_pixel_size, m_bbox.min, *m_support_polygons);
 
-            seed_fill_block(m_grid2, m_grid_size,
-                dilate_trimming_region(rasterize_polygons(m_grid_size, m_pixel_size, m_bbox.min, *m_trimming_polygons), m_grid_size),
-                grid_blocks, oversampling);
+            SupportRasterBuffers &buffers = m_raster_buffers->local();
+            rasterize_polygons(m_grid_size, m_pixel_size, m_bbox.min, *m_trimming_polygons, buffers.trimming);
+            dilate_trimming_region(buffers.trimming, m_grid_size, buffers.trimming_bits, buffers.trimming_dilated);
+            seed_fill_block(m_grid2, m_grid_size, buffers.trimming_dilated, grid_blocks, oversampling);
 
     #ifdef SLIC3R_DEBUG
             {
@@ -892,7 +938,7 @@ public:
         case smsGrid:
         {
     #ifdef SUPPORT_USE_AGG_RASTERIZER
-            Polygons support_polygons_simplified = contours_simplified(m_grid_size, m_pixel_size, m_bbox.min, m_grid2, offset_in_grid, fill_holes);
+            Polygons support_polygons_simplified = contours_simplified(m_grid_size, m_pixel_size, m_bbox.min, m_grid2, offset_in_grid, fill_holes, m_raster_buffers->local().cell_inside);
     #else // SUPPORT_USE_AGG_RASTERIZER
             // Generate islands, so each island may be tested for overlap with island_samples.
             assert(std::abs(2 * offset_in_grid) < m_grid.resolution());
@@ -1114,24 +1160,43 @@ private:
 
 #ifdef SUPPORT_USE_AGG_RASTERIZER
     // Dilate the trimming region (unmask the boundary pixels).
-    static std::vector<unsigned char> dilate_trimming_region(const std::vector<unsigned char> &trimming, const Vec2i32 &grid_size)
+    // A pixel stays masked if its whole 8-neighborhood is masked (4-neighborhood is not sufficient).
+    // The rows are packed into 64 bit words, so that the 3x3 neighborhood is evaluated for 64 pixels at once.
+    // The boundary rows / columns of the result are unmasked.
+    static void dilate_trimming_region(const std::vector<unsigned char> &trimming, const Vec2i32 &grid_size, std::vector<uint64_t> &bits, std::vector<unsigned char> &dilated)
     {
-        std::vector<unsigned char> dilated(trimming.size(), 0);
-        for (int r = 1; r + 1 < grid_size.y(); ++ r)
-            for (int c = 1; c + 1 < grid_size.x(); ++ c) {
-                //int addr = c + r * m_grid_size.x();
-                // 4-neighborhood is not sufficient.
-                // dilated[addr] = trimming[addr] != 0 && trimming[addr - 1] != 0 && trimming[addr + 1] != 0 && trimming[addr - m_grid_size.x()] != 0 && trimming[addr + m_grid_size.x()] != 0;
-                // 8-neighborhood
-                int addr = c + (r - 1) * grid_size.x();
-                bool b = trimming[addr - 1] != 0 && trimming[addr] != 0 && trimming[addr + 1] != 0;
-                addr += grid_size.x();
-                b = b && trimming[addr - 1] != 0 && trimming[addr] != 0 && trimming[addr + 1] != 0;
-                addr += grid_size.x();
-                b = b && trimming[addr - 1] != 0 && trimming[addr] != 0 && trimming[addr + 1] != 0;
-                dilated[addr - grid_size.x()] = b;
+        const int    cols  = grid_size.x();
+        const int    rows  = grid_size.y();
+        const size_t words = (size_t(cols) + 63) / 64;
+        bits.assign(words * size_t(rows), 0);
+        // Pack the mask and erode it horizontally.
+        for (int r = 0; r < rows; ++ r) {
+            const unsigned char *src = trimming.data() + size_t(r) * cols;
+            uint64_t            *row = bits.data() + size_t(r) * words;
+            for (int c = 0; c < cols; ++ c)
+                row[c >> 6] |= uint64_t(src[c] != 0) << (c & 63);
+            uint64_t prev = 0;
+            for (size_t w = 0; w < words; ++ w) {
+                uint64_t cur  = row[w];
+                uint64_t next = w + 1 < words ? row[w + 1] : 0;
+                row[w] = cur & ((cur << 1) | (prev >> 63)) & ((cur >> 1) | (next << 63));
+                prev   = cur;
             }
-        return dilated;
+        }
+        // Erode vertically and unpack.
+        dilated.assign(trimming.size(), 0);
+        for (int r = 1; r + 1 < rows; ++ r) {
+            const uint64_t *above = bits.data() + size_t(r - 1) * words;
+            const uint64_t *row   = above + words;
+            const uint64_t *below = row + words;
+            unsigned char  *dst   = dilated.data() + size_t(r) * cols;
+            for (size_t w = 0; w < words; ++ w)
+                if (uint64_t b = above[w] & row[w] & below[w]; b != 0) {
+                    // Skip the first and the last column.
+                    for (int c = std::max(int(w * 64), 1); c < std::min(int(w * 64) + 64, cols - 1); ++ c)
+                        dst[c] = (b >> (c & 63)) & 1;
+                }
+        }
     }
 
     // Seed fill each of the (oversampling x oversampling) block up to the dilated trimming region.
@@ -1243,6 +1308,7 @@ private:
     coordf_t                m_extrusion_width;
     // For snug supports: Morphological closing of support areas.
     coordf_t                m_support_material_closing_radius;
+    SupportRasterBuffersPerThread *m_raster_buffers { nullptr };
 
 #ifdef SUPPORT_USE_AGG_RASTERIZER
     Vec2i32                     m_grid_size;
@@ -1431,25 +1497,48 @@ namespace SupportMaterialInternal {
 std::vector<Polygons> PrintObjectSupportMaterial::buildplate_covered(const PrintObject &object) const
 {
     // Build support on a build plate only? If so, then collect and union all the surfaces below the current layer.
-    // Unfortunately this is an inherently serial process.
+    // This is a prefix sum of unions, which is calculated in parallel over blocks of layers: the slices are accumulated
+    // inside each block independently, then the union of all the layers below a block is added to the layers of the block.
     const bool            buildplate_only = this->build_plate_only();
     std::vector<Polygons> buildplate_covered;
     if (buildplate_only) {
         BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::buildplate_covered() - start";
-        buildplate_covered.assign(object.layers().size(), Polygons());
-        //FIXME prefix sum algorithm, parallelize it! Parallelization will also likely be more numerically stable.
-        for (size_t layer_id = 1; layer_id < object.layers().size(); ++ layer_id) {
-            const Layer &lower_layer = *object.layers()[layer_id-1];
-            // Merge the new slices with the preceding slices.
-            // Apply the safety offset to the newly added polygons, so they will connect
-            // with the polygons collected before,
-            // but don't apply the safety offset during the union operation as it would
-            // inflate the polygons over and over.
-            Polygons &covered = buildplate_covered[layer_id];
-            covered = buildplate_covered[layer_id - 1];
-            polygons_append(covered, offset(lower_layer.lslices, scale_(0.01)));
-            covered = union_(covered);
-        }
+        const size_t num_layers = object.layers().size();
+        buildplate_covered.assign(num_layers, Polygons());
+        // Layer 0 is not covered, blocks of about sqrt(num_layers) layers starting with layer 1 balance the serial accumulation
+        // inside a block with the serial accumulation over the blocks.
+        const size_t block_size = std::max<size_t>(8, size_t(std::ceil(std::sqrt(double(num_layers)))));
+        const size_t num_blocks = num_layers > 1 ? (num_layers - 2) / block_size + 1 : 0;
+        auto         block_begin = [block_size](size_t block_id) { return 1 + block_id * block_size; };
+        auto         block_end   = [block_size, num_layers](size_t block_id) { return std::min(num_layers, 1 + (block_id + 1) * block_size); };
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks, 1),
+            [&object, &buildplate_covered, &block_begin, &block_end](const tbb::blocked_range<size_t> &range) {
+            for (size_t block_id = range.begin(); block_id < range.end(); ++ block_id)
+                for (size_t layer_id = block_begin(block_id); layer_id < block_end(block_id); ++ layer_id) {
+                    const Layer &lower_layer = *object.layers()[layer_id - 1];
+                    // Merge the new slices with the preceding slices of this block.
+                    // Apply the safety offset to the newly added polygons, so they will connect
+                    // with the polygons collected before,
+                    // but don't apply the safety offset during the union operation as it would
+                    // inflate the polygons over and over.
+                    Polygons &covered = buildplate_covered[layer_id];
+                    if (layer_id > block_begin(block_id))
+                        covered = buildplate_covered[layer_id - 1];
+                    polygons_append(covered, offset(lower_layer.lslices, scale_(0.01)));
+                    covered = union_(covered);
+                }
+        });
+        // Union of all the layers below each block.
+        std::vector<Polygons> covered_below_block(num_blocks);
+        for (size_t block_id = 1; block_id < num_blocks; ++ block_id)
+            covered_below_block[block_id] = union_(covered_below_block[block_id - 1], buildplate_covered[block_begin(block_id) - 1]);
+        tbb::parallel_for(tbb::blocked_range<size_t>(std::min(block_begin(1), num_layers), num_layers),
+            [&buildplate_covered, &covered_below_block, block_size](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+                Polygons &covered = buildplate_covered[layer_id];
+                covered = union_(covered_below_block[(layer_id - 1) / block_size], covered);
+            }
+        });
         BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::buildplate_covered() - end";
     }
     return buildplate_covered;
@@ -1826,14 +1915,15 @@ static inline void fill_contact_layer(
     const Polygons          &enforcer_polygons, 
     const Polygons          &lower_layer_polygons,
     const Flow              &support_material_flow,
-    float                    no_interface_offset
+    float                    no_interface_offset,
+    SupportRasterBuffersPerThread &raster_buffers
 #ifdef SLIC3R_DEBUG
     , size_t                 iRun,
     const Layer             &layer
 #endif // SLIC3R_DEBUG
     )
 {
-    const SupportGridParams grid_params(object_config, support_material_flow);
+    const SupportGridParams grid_params(object_config, support_material_flow, raster_buffers);
 
     Polygons lower_layer_polygons_for_dense_interface_cache;
     auto lower_layer_polygons_for_dense_interface = [&lower_layer_polygons_for_dense_interface_cache, &lower_layer_polygons, no_interface_offset]() -> const Polygons& {
@@ -2040,8 +2130,9 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
     // and the other for the overhangs extruded with a normal flow.
     contact_out.assign(num_layers * 2, nullptr);
     tbb::spin_mutex layer_storage_mutex;
+    SupportRasterBuffersPerThread raster_buffers;
     tbb::parallel_for(tbb::blocked_range<size_t>(this->has_raft() ? 0 : 1, num_layers),
-        [this, &object, &annotations, &layer_storage, &layer_storage_mutex, &contact_out]
+        [this, &object, &annotations, &layer_storage, &layer_storage_mutex, &raster_buffers, &contact_out]
         (const tbb::blocked_range<size_t>& range) {
             for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) 
             {
@@ -2064,7 +2155,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                         // Fill the non-bridging layer with polygons.
                         fill_contact_layer(*new_layer, layer_id, *m_slicing_params,
                             *m_object_config, slices_margin, overhang_polygons, contact_polygons, enforcer_polygons, lower_layer_polygons,
-                            m_support_params.support_material_flow, no_interface_offset
+                            m_support_params.support_material_flow, no_interface_offset, raster_buffers
                     #ifdef SLIC3R_DEBUG
                             , iRun, layer
                     #endif // SLIC3R_DEBUG
@@ -2321,7 +2412,8 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::bottom_conta
 
     //FIXME higher expansion_to_slice here? why?
     //const auto   expansion_to_slice = m_support_material_flow.scaled_spacing() / 2 + 25;
-    const SupportGridParams grid_params(*m_object_config, m_support_params.support_material_flow);
+    SupportRasterBuffersPerThread raster_buffers;
+    const SupportGridParams grid_params(*m_object_config, m_support_params.support_material_flow, raster_buffers);
     const bool buildplate_only = ! buildplate_covered.empty();
 
     // Allocate empty surface areas, one per object layer.
@@ -2339,116 +2431,176 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::bottom_conta
     Polygons  enforcers_projection;
     // Last top contact layer visited when collecting the projection of contact areas.
     int       contact_idx = int(top_contacts.size()) - 1;
-    for (int layer_id = int(object.total_layer_count()) - 2; layer_id >= 0; -- layer_id) {
-        BOOST_LOG_TRIVIAL(trace) << "Support generator - bottom_contact_layers - layer " << layer_id;
-        const Layer &layer = *object.get_layer(layer_id);
-        // Collect projections of all contact areas above or at the same level as this top surface.
+    // Layer to be projected next.
+    int       layer_id    = int(object.total_layer_count()) - 2;
+
+    // The support areas are projected downwards layer by layer, while the bottom contacts are detected and the support areas
+    // above them are trimmed in a second stage of a pipeline, lagging behind the projection. Both stages process
+    // the layers in order from the top down, thus the result is the same as if the layers were processed one by one.
+    struct ProjectedLayer {
+        const Layer *layer { nullptr };
+        int          contact_idx { 0 };
+        // Projection of the contact areas above this layer to detect the bottom contacts with.
+        Polygons     overhangs_for_bottom_contacts;
 #ifdef SLIC3R_DEBUG
-        Polygons polygons_new;
-        Polygons enforcers_new;
+        Polygons     polygons_new;
 #endif // SLIC3R_DEBUG
-        for (; contact_idx >= 0 && top_contacts[contact_idx]->print_z > layer.print_z - EPSILON; -- contact_idx) {
-            MyLayer &top_contact = *top_contacts[contact_idx];
-#ifndef SLIC3R_DEBUG
+    };
+    const auto project = tbb::make_filter<void, ProjectedLayer>(slic3r_tbb_filtermode::serial_in_order,
+        [&object, &top_contacts, &buildplate_covered, &layer_support_areas, &grid_params, buildplate_only, &overhangs_projection, &enforcers_projection, &contact_idx, &layer_id
+#ifdef SLIC3R_DEBUG
+        , iRun
+#endif // SLIC3R_DEBUG
+        ](tbb::flow_control &fc) -> ProjectedLayer {
+        for (; layer_id >= 0; -- layer_id) {
+            BOOST_LOG_TRIVIAL(trace) << "Support generator - bottom_contact_layers - layer " << layer_id;
+            const Layer &layer = *object.get_layer(layer_id);
+            // Collect projections of all contact areas above or at the same level as this top surface.
+#ifdef SLIC3R_DEBUG
             Polygons polygons_new;
             Polygons enforcers_new;
 #endif // SLIC3R_DEBUG
-            // Contact surfaces are expanded away from the object, trimmed by the object.
-            // Use a slight positive offset to overlap the touching regions.
+            for (; contact_idx >= 0 && top_contacts[contact_idx]->print_z > layer.print_z - EPSILON; -- contact_idx) {
+                MyLayer &top_contact = *top_contacts[contact_idx];
+#ifndef SLIC3R_DEBUG
+                Polygons polygons_new;
+                Polygons enforcers_new;
+#endif // SLIC3R_DEBUG
+                // Contact surfaces are expanded away from the object, trimmed by the object.
+                // Use a slight positive offset to overlap the touching regions.
 #if 0
-            // Merge and collect the contact polygons. The contact polygons are inflated, but not extended into a grid form.
-            polygons_append(polygons_new,  offset(*top_contact.contact_polygons,  SCALED_EPSILON));
-            if (top_contact.enforcer_polygons)
-                polygons_append(enforcers_new, offset(*top_contact.enforcer_polygons, SCALED_EPSILON));
+                // Merge and collect the contact polygons. The contact polygons are inflated, but not extended into a grid form.
+                polygons_append(polygons_new,  offset(*top_contact.contact_polygons,  SCALED_EPSILON));
+                if (top_contact.enforcer_polygons)
+                    polygons_append(enforcers_new, offset(*top_contact.enforcer_polygons, SCALED_EPSILON));
 #else
-            // Consume the contact_polygons. The contact polygons are already expanded into a grid form, and they are a tiny bit smaller
-            // than the grid cells.
-            polygons_append(polygons_new,  std::move(*top_contact.contact_polygons));
-            if (top_contact.enforcer_polygons)
-                polygons_append(enforcers_new, std::move(*top_contact.enforcer_polygons));
+                // Consume the contact_polygons. The contact polygons are already expanded into a grid form, and they are a tiny bit smaller
+                // than the grid cells.
+                polygons_append(polygons_new,  std::move(*top_contact.contact_polygons));
+                if (top_contact.enforcer_polygons)
+                    polygons_append(enforcers_new, std::move(*top_contact.enforcer_polygons));
 #endif
-            // These are the overhang surfaces. They are touching the object and they are not expanded away from the object.
-            // Use a slight positive offset to overlap the touching regions.
-            polygons_append(polygons_new, expand(*top_contact.overhang_polygons, double(SCALED_EPSILON)));
-            polygons_append(overhangs_projection, union_(polygons_new));
-            polygons_append(enforcers_projection, enforcers_new);
-        }
-        if (overhangs_projection.empty() && enforcers_projection.empty())
-            continue;
-
-        // Overhangs_projection will be filled in asynchronously, move it away.
-        Polygons overhangs_projection_raw = union_(std::move(overhangs_projection));
-        Polygons enforcers_projection_raw = union_(std::move(enforcers_projection));
+                // These are the overhang surfaces. They are touching the object and they are not expanded away from the object.
+                // Use a slight positive offset to overlap the touching regions.
+                polygons_append(polygons_new, expand(*top_contact.overhang_polygons, double(SCALED_EPSILON)));
+                polygons_append(overhangs_projection, union_(polygons_new));
+                polygons_append(enforcers_projection, enforcers_new);
+            }
+            if (overhangs_projection.empty() && enforcers_projection.empty())
+                continue;
 
-        tbb::task_group task_group;
-        const Polygons &overhangs_for_bottom_contacts = buildplate_only ? enforcers_projection_raw : overhangs_projection_raw;
-        if (! overhangs_for_bottom_contacts.empty())
-            // Find the bottom contact layers above the top surfaces of this layer.
-            task_group.run([this, &object, &layer, &top_contacts, contact_idx, &layer_storage, &layer_support_areas, &bottom_contacts, &overhangs_for_bottom_contacts
-    #ifdef SLIC3R_DEBUG
-                , iRun, &polygons_new
-    #endif // SLIC3R_DEBUG
-                ] {
-                    // Find the bottom contact layers above the top surfaces of this layer.
-                    MyLayer *layer_new = detect_bottom_contacts(
-                        *m_slicing_params, m_support_params, object, layer, top_contacts, contact_idx, layer_storage, layer_support_areas, overhangs_for_bottom_contacts
-#ifdef SLIC3R_DEBUG
-                        , iRun, polygons_new
-#endif // SLIC3R_DEBUG
-                    );
-                    if (layer_new)
-                        bottom_contacts.push_back(layer_new);
-                });
+            // Overhangs_projection will be filled in asynchronously, move it away.
+            Polygons overhangs_projection_raw = union_(std::move(overhangs_projection));
+            Polygons enforcers_projection_raw = union_(std::move(enforcers_projection));
 
-        Polygons &layer_support_area = layer_support_areas[layer_id];
-        Polygons *layer_buildplate_covered = buildplate_covered.empty() ? nullptr : &buildplate_covered[layer_id];
-        // Filtering the propagated support columns to two extrusions, overlapping by maximum 20%.
-//        float column_propagation_filtering_radius = scaled<float>(0.8 * 0.5 * (m_support_params.support_material_flow.spacing() + m_support_params.support_material_flow.width()));
-        task_group.run([&grid_params, &overhangs_projection, &overhangs_projection_raw, &layer, &layer_support_area, layer_buildplate_covered /* , column_propagation_filtering_radius */
+            tbb::task_group task_group;
+            Polygons &layer_support_area = layer_support_areas[layer_id];
+            Polygons *layer_buildplate_covered = buildplate_covered.empty() ? nullptr : &buildplate_covered[layer_id];
+            // Filtering the propagated support columns to two extrusions, overlapping by maximum 20%.
+//            float column_propagation_filtering_radius = scaled<float>(0.8 * 0.5 * (m_support_params.support_material_flow.spacing() + m_support_params.support_material_flow.width()));
+            task_group.run([&grid_params, &overhangs_projection, &overhangs_projection_raw, &layer, &layer_support_area, layer_buildplate_covered /* , column_propagation_filtering_radius */
 #ifdef SLIC3R_DEBUG 
-            , iRun, layer_id
+                , iRun, layer_id
 #endif /* SLIC3R_DEBUG */
-            ] {
-                // buildplate_covered[layer_id] will be consumed here.
-                std::tie(layer_support_area, overhangs_projection) = project_support_to_grid(layer, grid_params, overhangs_projection_raw, layer_buildplate_covered
+                ] {
+                    // buildplate_covered[layer_id] will be consumed here.
+                    std::tie(layer_support_area, overhangs_projection) = project_support_to_grid(layer, grid_params, overhangs_projection_raw, layer_buildplate_covered
 #ifdef SLIC3R_DEBUG 
-                    , iRun, layer_id, "general"
+                        , iRun, layer_id, "general"
 #endif /* SLIC3R_DEBUG */
-                );
-                // When propagating support areas downwards, stop propagating the support column if it becomes too thin to be printable.
-                //overhangs_projection = opening(overhangs_projection, column_propagation_filtering_radius);
-            });
+                    );
+                    // When propagating support areas downwards, stop propagating the support column if it becomes too thin to be printable.
+                    //overhangs_projection = opening(overhangs_projection, column_propagation_filtering_radius);
+                });
 
-        Polygons layer_support_area_enforcers;
-        if (! enforcers_projection.empty())
-            // Project the enforcers polygons downwards, don't trim them with the "buildplate only" polygons.
-            task_group.run([&grid_params, &enforcers_projection, &enforcers_projection_raw, &layer, &layer_support_area_enforcers
+            Polygons layer_support_area_enforcers;
+            if (! enforcers_projection.empty())
+                // Project the enforcers polygons downwards, don't trim them with the "buildplate only" polygons.
+                task_group.run([&grid_params, &enforcers_projection, &enforcers_projection_raw, &layer, &layer_support_area_enforcers
 #ifdef SLIC3R_DEBUG 
-                , iRun, layer_id
+                    , iRun, layer_id
 #endif /* SLIC3R_DEBUG */
-            ]{
-                std::tie(layer_support_area_enforcers, enforcers_projection) = project_support_to_grid(layer, grid_params, enforcers_projection_raw, nullptr
+                ]{
+                    std::tie(layer_support_area_enforcers, enforcers_projection) = project_support_to_grid(layer, grid_params, enforcers_projection_raw, nullptr
 #ifdef SLIC3R_DEBUG 
-                    , iRun, layer_id, "enforcers"
+                        , iRun, layer_id, "enforcers"
 #endif /* SLIC3R_DEBUG */
-                );
-            });
+                    );
+                });
 
-        task_group.wait();
+            task_group.wait();
 
-        if (! layer_support_area_enforcers.empty()) {
-            if (layer_support_area.empty())
-                layer_support_area = std::move(layer_support_area_enforcers);
-            else
-                layer_support_area = union_(layer_support_area, layer_support_area_enforcers);
+            if (! layer_support_area_enforcers.empty()) {
+                if (layer_support_area.empty())
+                    layer_support_area = std::move(layer_support_area_enforcers);
+                else
+                    layer_support_area = union_(layer_support_area, layer_support_area_enforcers);
+            }
+
+            ProjectedLayer out;
+            out.layer       = &layer;
+            out.contact_idx = contact_idx;
+            out.overhangs_for_bottom_contacts = buildplate_only ? std::move(enforcers_projection_raw) : std::move(overhangs_projection_raw);
+#ifdef SLIC3R_DEBUG
+            out.polygons_new = std::move(polygons_new);
+#endif // SLIC3R_DEBUG
+            -- layer_id;
+            return out;
+        } // over all layers downwards
+        fc.stop();
+        return ProjectedLayer();
+    });
+    const auto detect = tbb::make_filter<ProjectedLayer, void>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &object, &top_contacts, &layer_storage, &layer_support_areas, &bottom_contacts
+#ifdef SLIC3R_DEBUG
+        , iRun
+#endif // SLIC3R_DEBUG
+        ](ProjectedLayer in) {
+        if (! in.overhangs_for_bottom_contacts.empty()) {
+            // Find the bottom contact layers above the top surfaces of this layer.
+            // The support areas of the layers above this layer, which are trimmed by the bottom contacts, have already been projected.
+            MyLayer *layer_new = detect_bottom_contacts(
+                *m_slicing_params, m_support_params, object, *in.layer, top_contacts, in.contact_idx, layer_storage, layer_support_areas, in.overhangs_for_bottom_contacts
+#ifdef SLIC3R_DEBUG
+                , iRun, in.polygons_new
+#endif // SLIC3R_DEBUG
+            );
+            if (layer_new)
+                bottom_contacts.push_back(layer_new);
         }
-    } // over all layers downwards
+    });
+    // A few layers in flight are enough to overlap the two stages.
+    tbb::parallel_pipeline(4, project & detect);
 
     std::reverse(bottom_contacts.begin(), bottom_contacts.end());
     trim_support_layers_by_object(object, bottom_contacts, m_slicing_params->gap_support_object, m_slicing_params->gap_object_support, m_support_params.gap_xy); //m_slicing_params.soluble_interface ? 0.
     return bottom_contacts;
 }
 
+PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::tree_bottom_contact_layers(
+    const PrintObject &object, const MyLayersPtr &top_contacts, const std::vector<Polygons> &branch_landings,
+    MyLayerStorage &layer_storage, std::vector<Polygons> &layer_support_areas) const
+{
+    MyLayersPtr bottom_contacts;
+    for (size_t layer_id = 0; layer_id < branch_landings.size(); ++ layer_id)
+        if (! branch_landings[layer_id].empty()) {
+            const Layer &layer = *object.layers()[layer_id];
+            // Index of the last top contact layer below this object layer.
+            int contact_idx = int(std::lower_bound(top_contacts.begin(), top_contacts.end(), layer.print_z - EPSILON,
+                [](const MyLayer *l, coordf_t z) { return l->print_z < z; }) - top_contacts.begin()) - 1;
+            MyLayer *layer_new = detect_bottom_contacts(
+                *m_slicing_params, m_support_params, object, layer, top_contacts, contact_idx, layer_storage, layer_support_areas, branch_landings[layer_id]
+#ifdef SLIC3R_DEBUG
+                , 0, branch_landings[layer_id]
+#endif // SLIC3R_DEBUG
+            );
+            if (layer_new)
+                bottom_contacts.push_back(layer_new);
+        }
+    trim_support_layers_by_object(object, bottom_contacts, m_slicing_params->gap_support_object, m_slicing_params->gap_object_support, m_support_params.gap_xy);
+    return bottom_contacts;
+}
+
 // FN_HIGHER_EQUAL: the provided object pointer has a Z value >= of an internal threshold.
 // Find the first item with Z value >= of an internal threshold of fn_higher_equal.
 // If no vec item with Z value >= of an internal threshold of fn_higher_equal is found, return vec.size()
@@ -191,6 +191,12 @@ private:
 		const PrintObject &object, const MyLayersPtr &top_contacts, std::vector<Polygons> &buildplate_covered, 
 		MyLayerStorage &layer_storage, std::vector<Polygons> &layer_support_areas) const;
 
+	// Generate bottom contact layers below the branches of tree supports standing on the top surfaces of the object.
+	// branch_landings are the lowest sections of these branches, indexed by the object layer they stand on.
+	MyLayersPtr tree_bottom_contact_layers(
+		const PrintObject &object, const MyLayersPtr &top_contacts, const std::vector<Polygons> &branch_landings,
+		MyLayerStorage &layer_storage, std::vector<Polygons> &layer_support_areas) const;
+
 	// Trim the top_contacts layers with the bottom_contacts layers if they overlap, so there would not be enough vertical space for both of them.
 	void trim_top_contacts_by_bottom_contacts(const PrintObject &object, const MyLayersPtr &bottom_contacts, MyLayersPtr &top_contacts) const;
 
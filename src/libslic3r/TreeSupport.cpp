@@ -0,0 +1,340 @@
+#include "AABBTreeLines.hpp"
+#include "BoundingBox.hpp"
+#include "ClipperUtils.hpp"
+#include "ExPolygon.hpp"
+#include "Geometry.hpp"
+#include "KDTreeIndirect.hpp"
+#include "Layer.hpp"
+#include "Print.hpp"
+#include "TreeSupport.hpp"
+
+#include <cmath>
+
+#include <boost/log/trivial.hpp>
+
+#include <tbb/parallel_for.h>
+
+namespace Slic3r {
+
+TreeSupportParams::TreeSupportParams(const PrintObjectConfig &object_config, double support_spacing, double gap_xy) :
+    tan_angle(std::tan(Geometry::deg2rad(std::clamp(object_config.support_tree_angle.value, 0., 85.)))),
+    tip_radius(0.5 * object_config.support_tree_tip_diameter.value),
+    branch_radius(0.5 * object_config.support_tree_branch_diameter.value),
+    tan_branch_radius_angle(std::tan(Geometry::deg2rad(std::clamp(object_config.support_tree_branch_diameter_angle.value, 0., 15.)))),
+    branch_distance(support_spacing),
+    gap_xy(gap_xy)
+{}
+
+// Region of a single object layer to be avoided by the branches: the object slices expanded by the XY gap,
+// possibly extended by the object projected to the print bed.
+class TreeSupportObstacle
+{
+public:
+    void init(ExPolygons &&islands)
+    {
+        m_islands = std::move(islands);
+        m_bboxes.reserve(m_islands.size());
+        for (const ExPolygon &island : m_islands) {
+            m_bboxes.emplace_back(get_extents(island.contour));
+            for (const Line &line : island.lines())
+                m_lines.emplace_back(unscale(line.a), unscale(line.b));
+        }
+        m_tree = AABBTreeLines::build_aabb_tree_over_indexed_lines(m_lines);
+    }
+
+    bool empty() const { return m_islands.empty(); }
+
+    // Signed distance of an unscaled point to the obstacle, negative inside. Returns the closest point on the obstacle boundary.
+    double signed_distance(const Vec2d &pt, Vec2d &closest) const
+    {
+        if (m_lines.empty())
+            return std::numeric_limits<double>::max();
+        size_t hit_idx;
+        double dist   = std::sqrt(AABBTreeLines::squared_distance_to_indexed_lines(m_lines, m_tree, pt, hit_idx, closest));
+        Point  pt_scaled(scaled<coord_t>(pt.x()), scaled<coord_t>(pt.y()));
+        for (size_t i = 0; i < m_islands.size(); ++ i)
+            if (m_bboxes[i].contains(pt_scaled) && m_islands[i].contains(pt_scaled))
+                return - dist;
+        return dist;
+    }
+
+private:
+    ExPolygons                          m_islands;
+    std::vector<BoundingBox>            m_bboxes;
+    std::vector<Linef>                  m_lines;
+    AABBTreeIndirect::Tree<2, double>   m_tree;
+};
+
+struct TreeSupportNode {
+    // Unscaled position of the center of the branch.
+    Vec2d   position;
+    // Vertical distance from the tip of the branch.
+    double  height;
+    // Indices of the branch sections one layer above, which continue into this section: none for a tip, two for merged branches.
+    size_t  above[2] { size_t(-1), size_t(-1) };
+    // The branch section is not supported from below, it is not to be printed.
+    bool    pruned { false };
+};
+
+// Radius of a branch at a height below its tip: a cone from the tip radius to the branch radius, thickening slowly further down.
+static inline double tree_branch_radius(const TreeSupportParams &params, double height)
+{
+    return std::max(params.tip_radius, std::min(params.branch_radius, params.tip_radius + height)) + height * params.tan_branch_radius_angle;
+}
+
+// Place a branch moving from "from" towards "target", so that it keeps its radius off the obstacle.
+// A branch, which could not be placed outside of the obstacle, ends on the object. Returns false in that case.
+static bool tree_place_branch(const TreeSupportObstacle &obstacle, const Vec2d &from, const Vec2d &target, double radius, double max_move, Vec2d &out)
+{
+    if (obstacle.empty()) {
+        out = target;
+        return true;
+    }
+    for (const Vec2d &pt : { target, from }) {
+        Vec2d  closest;
+        double dist = obstacle.signed_distance(pt, closest);
+        if (dist >= radius) {
+            out = pt;
+            return true;
+        }
+        if (double len = std::abs(dist); len > EPSILON) {
+            // Push the branch out of the obstacle along the normal of its boundary.
+            Vec2d normal  = (dist > 0 ? pt - closest : closest - pt) / len;
+            Vec2d escaped = closest + normal * radius;
+            Vec2d closest2;
+            if ((escaped - from).squaredNorm() <= sqr(max_move) && obstacle.signed_distance(escaped, closest2) > 0) {
+                out = escaped;
+                return true;
+            }
+        }
+        if (dist >= 0) {
+            // The center of the branch is outside of the obstacle, its overlap with the object will be trimmed.
+            out = pt;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Move the branches one layer down by dz. Each branch is attracted by its closest branch within max_merge_distance,
+// branches meeting each other are merged. Indices of the branches, which could not be placed outside of the obstacle, are returned in ended.
+static std::vector<TreeSupportNode> tree_descend_branches(
+    const std::vector<TreeSupportNode> &nodes, const TreeSupportObstacle &obstacle, double dz, double max_move, double max_merge_distance,
+    const TreeSupportParams &params, std::vector<size_t> &ended)
+{
+    const size_t npos = size_t(-1);
+    auto coordinate_fn = [&nodes](size_t idx, size_t dimension) { return nodes[idx].position[dimension]; };
+    KDTreeIndirect<2, double, decltype(coordinate_fn)> kdtree(coordinate_fn, nodes.size());
+
+    std::vector<size_t>          closest(nodes.size(), npos);
+    std::vector<TreeSupportNode> moved(nodes.size());
+    std::vector<char>            alive(nodes.size(), false);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nodes.size()), [&nodes, &kdtree, &closest, max_merge_distance](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i) {
+            size_t j = find_closest_point(kdtree, nodes[i].position, [i](size_t idx) { return idx != i; });
+            if (j != npos && (nodes[j].position - nodes[i].position).squaredNorm() < sqr(max_merge_distance))
+                closest[i] = j;
+        }
+    });
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nodes.size()), [&nodes, &obstacle, &closest, &moved, &alive, &params, dz, max_move](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i) {
+            const TreeSupportNode &node   = nodes[i];
+            Vec2d                  target = node.position;
+            if (size_t j = closest[i]; j != npos) {
+                Vec2d  v = nodes[j].position - node.position;
+                double d = v.norm();
+                if (closest[j] == i && d <= 2. * max_move)
+                    // Mutually closest branches within reach meet halfway.
+                    target = 0.5 * (node.position + nodes[j].position);
+                else if (d > EPSILON)
+                    target += v * (std::min(max_move, d) / d);
+            }
+            moved[i].height = node.height + dz;
+            alive[i] = tree_place_branch(obstacle, node.position, target, tree_branch_radius(params, moved[i].height), max_move, moved[i].position);
+        }
+    });
+
+    ended.clear();
+    for (size_t i = 0; i < nodes.size(); ++ i)
+        if (! alive[i])
+            ended.emplace_back(i);
+
+    // Merge the mutually closest branches, which met.
+    std::vector<TreeSupportNode> out;
+    out.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++ i)
+        if (alive[i]) {
+            TreeSupportNode node = moved[i];
+            node.above[0] = i;
+            if (size_t j = closest[i]; j != npos && j > i && closest[j] == i && alive[j] && (moved[j].position - node.position).squaredNorm() <= sqr(max_move)) {
+                Vec2d closest_pt;
+                Vec2d center = 0.5 * (node.position + moved[j].position);
+                if (obstacle.empty() || obstacle.signed_distance(center, closest_pt) >= 0) {
+                    node.position = center;
+                    node.height   = std::max(node.height, moved[j].height);
+                    node.above[1] = j;
+                    alive[j]      = false;
+                }
+            }
+            out.emplace_back(node);
+        }
+    return out;
+}
+
+// Tips of the branches supporting a contact layer: points of a regular grid inside the contact areas,
+// at least a single point for each contact island.
+static std::vector<Vec2d> tree_sample_tips(const Polygons &contacts, double branch_distance)
+{
+    std::vector<Vec2d> out;
+    const coord_t      step = std::max<coord_t>(scaled<coord_t>(branch_distance), 1);
+    for (const ExPolygon &island : union_ex(contacts)) {
+        const size_t     num_tips_old = out.size();
+        const BoundingBox bbox        = get_extents(island.contour);
+        for (coord_t y = (bbox.min.y() / step) * step; y <= bbox.max.y(); y += step)
+            for (coord_t x = (bbox.min.x() / step) * step; x <= bbox.max.x(); x += step)
+                if (Point pt(x, y); island.contains(pt))
+                    out.emplace_back(unscale(pt));
+        if (out.size() == num_tips_old) {
+            // The island is smaller than the grid.
+            Point pt = island.contour.centroid();
+            out.emplace_back(unscale(island.contains(pt) ? pt : island.contour.points.front()));
+        }
+    }
+    return out;
+}
+
+static Polygon tree_branch_circle(const Vec2d &center, double radius)
+{
+    const size_t num_segments = std::clamp<size_t>(size_t(std::ceil(2. * M_PI * radius / 0.4)), 8, 64);
+    Polygon      out;
+    out.points.reserve(num_segments);
+    for (size_t i = 0; i < num_segments; ++ i) {
+        double angle = 2. * M_PI * double(i) / double(num_segments);
+        out.points.emplace_back(scaled<coord_t>(center.x() + radius * std::cos(angle)), scaled<coord_t>(center.y() + radius * std::sin(angle)));
+    }
+    return out;
+}
+
+std::vector<Polygons> tree_support_layer_support_areas(
+    const PrintObject                               &object,
+    const PrintObjectSupportMaterial::MyLayersPtr   &top_contacts,
+    const std::vector<Polygons>                     &buildplate_covered,
+    const TreeSupportParams                         &params,
+    std::vector<Polygons>                           &branch_landings)
+{
+    const size_t          num_layers = object.layers().size();
+    std::vector<Polygons> out(num_layers);
+    branch_landings.assign(num_layers, Polygons());
+    if (top_contacts.empty() || num_layers == 0)
+        return out;
+
+    BOOST_LOG_TRIVIAL(debug) << "tree_support_layer_support_areas() - start";
+
+    // Object layer below each top contact layer, where its branches start.
+    auto layer_below = [&object](coordf_t z) {
+        auto it = std::upper_bound(object.layers().begin(), object.layers().end(), z + EPSILON, [](coordf_t z, const Layer *layer) { return z < layer->print_z; });
+        return int(it - object.layers().begin()) - 1;
+    };
+    std::vector<std::vector<Vec2d>> tips(num_layers);
+    int layer_top = -1;
+    {
+        std::vector<std::vector<Vec2d>> contact_tips(top_contacts.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, top_contacts.size()), [&top_contacts, &contact_tips, &params](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i)
+                contact_tips[i] = tree_sample_tips(top_contacts[i]->polygons, params.branch_distance);
+        });
+        for (size_t i = 0; i < top_contacts.size(); ++ i)
+            if (int layer_id = layer_below(top_contacts[i]->bottom_z); layer_id >= 0 && ! contact_tips[i].empty()) {
+                append(tips[layer_id], std::move(contact_tips[i]));
+                layer_top = std::max(layer_top, layer_id);
+            }
+    }
+    if (layer_top < 0)
+        // All the contacts are supported by the first layer of support, which is not synchronized with the object layers.
+        return out;
+
+    // Regions to be avoided by the branches at each object layer.
+    std::vector<TreeSupportObstacle> obstacles(layer_top + 1);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, obstacles.size()), [&object, &buildplate_covered, &obstacles, &params](const tbb::blocked_range<size_t> &range) {
+        for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+            Polygons obstacle = offset(object.layers()[layer_id]->lslices, scaled<float>(params.gap_xy));
+            if (! buildplate_covered.empty())
+                append(obstacle, buildplate_covered[layer_id]);
+            obstacles[layer_id].init(union_ex(obstacle));
+        }
+    });
+
+    // Grow the branches from the top down, layer by layer.
+    std::vector<std::vector<TreeSupportNode>> layer_nodes(layer_top + 1);
+    // Remove the branch section and all the sections above it, which are left without support.
+    auto prune = [&layer_nodes](int layer_id, size_t idx) {
+        std::vector<std::pair<int, size_t>> stack { { layer_id, idx } };
+        while (! stack.empty()) {
+            auto [l, i] = stack.back();
+            stack.pop_back();
+            TreeSupportNode &node = layer_nodes[l][i];
+            node.pruned = true;
+            for (size_t j : node.above)
+                if (j != size_t(-1))
+                    stack.emplace_back(l + 1, j);
+        }
+    };
+    size_t              num_landed = 0;
+    size_t              num_pruned = 0;
+    std::vector<size_t> ended;
+    for (int layer_id = layer_top; layer_id >= 0; -- layer_id) {
+        std::vector<TreeSupportNode> &nodes = layer_nodes[layer_id];
+        if (layer_id < layer_top && ! layer_nodes[layer_id + 1].empty()) {
+            std::vector<TreeSupportNode> &nodes_above = layer_nodes[layer_id + 1];
+            const Layer                  &layer       = *object.layers()[layer_id];
+            const double                  dz          = object.layers()[layer_id + 1]->print_z - layer.print_z;
+            const double                  max_move    = dz * params.tan_angle;
+            // Two branches could merge if they meet above the print bed.
+            nodes = tree_descend_branches(nodes_above, obstacles[layer_id], dz, max_move, 2. * max_move * (layer_id + 1), params, ended);
+            for (size_t i : ended) {
+                const TreeSupportNode &node = nodes_above[i];
+                Point                  pt(scaled<coord_t>(node.position.x()), scaled<coord_t>(node.position.y()));
+                bool                   over_object = false;
+                if (buildplate_covered.empty())
+                    for (const ExPolygon &island : layer.lslices)
+                        if (island.contains(pt)) {
+                            over_object = true;
+                            break;
+                        }
+                if (over_object) {
+                    // The branch stands on the top surface of this layer, a bottom contact layer will be placed below its lowest section.
+                    branch_landings[layer_id].emplace_back(tree_branch_circle(node.position, tree_branch_radius(params, node.height)));
+                    ++ num_landed;
+                } else {
+                    // The branch ended in the gap around the object or above the object with support on build plate only.
+                    // Nothing would carry it, thus it is removed up to its tip, including the branches merged into it.
+                    prune(layer_id + 1, i);
+                    ++ num_pruned;
+                }
+            }
+        }
+        for (const Vec2d &tip : tips[layer_id]) {
+            Vec2d closest;
+            if (obstacles[layer_id].empty() || obstacles[layer_id].signed_distance(tip, closest) >= 0)
+                nodes.push_back({ tip, 0. });
+        }
+    }
+    BOOST_LOG_TRIVIAL(debug) << "tree_support_layer_support_areas() - " << num_landed << " branches landed on the object, " << num_pruned << " branches pruned";
+
+    // Cross sections of the branches.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, layer_nodes.size()), [&layer_nodes, &out, &params](const tbb::blocked_range<size_t> &range) {
+        for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+            Polygons circles;
+            circles.reserve(layer_nodes[layer_id].size());
+            for (const TreeSupportNode &node : layer_nodes[layer_id])
+                if (! node.pruned)
+                    circles.emplace_back(tree_branch_circle(node.position, tree_branch_radius(params, node.height)));
+            out[layer_id] = union_(circles);
+        }
+    });
+
+    BOOST_LOG_TRIVIAL(debug) << "tree_support_layer_support_areas() - end";
+    return out;
+}
+
+} // namespace Slic3r
@@ -0,0 +1,46 @@
+#ifndef slic3r_TreeSupport_hpp_
+#define slic3r_TreeSupport_hpp_
+
+#include "SupportMaterial.hpp"
+
+namespace Slic3r {
+
+class PrintObject;
+class PrintObjectConfig;
+
+// Parameters of the branching supports, in unscaled coordinates.
+struct TreeSupportParams {
+    TreeSupportParams(const PrintObjectConfig &object_config, double support_spacing, double gap_xy);
+
+    // Tangent of the maximum angle of a branch from the vertical.
+    double  tan_angle;
+    // Radius of the tips of the branches.
+    double  tip_radius;
+    // Radius of the branches below their tips.
+    double  branch_radius;
+    // Tangent of the cone, by which the branches thicken with the distance from their tips.
+    double  tan_branch_radius_angle;
+    // Distance of the tips supporting a single contact area.
+    double  branch_distance;
+    // Horizontal gap between the branches and the object.
+    double  gap_xy;
+};
+
+// Grow branches from the top contact layers down to the print bed, avoiding the object. Branches closing to each other merge,
+// branches, which could not avoid the object, end on its top surface.
+// Returns the cross sections of the trees at each object layer, to be used as the layer_support_areas
+// of PrintObjectSupportMaterial::generate_base_layers().
+// branch_landings receives the lowest sections of the branches ending on the object, indexed by the object layer they stand on,
+// to place bottom contact layers below them. Branches ending elsewhere would not be supported, they are removed.
+// If buildplate_covered is not empty (support on build plate only), the branches avoid the object projected to the print bed as well
+// and no branch ends on the object.
+std::vector<Polygons> tree_support_layer_support_areas(
+    const PrintObject                               &object,
+    const PrintObjectSupportMaterial::MyLayersPtr   &top_contacts,
+    const std::vector<Polygons>                     &buildplate_covered,
+    const TreeSupportParams                         &params,
+    std::vector<Polygons>                           &branch_landings);
+
+} // namespace Slic3r
+
+#endif /* slic3r_TreeSupport_hpp_ */
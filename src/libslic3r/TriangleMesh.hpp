@@ -92,6 +92,8 @@ public:
     TriangleMesh(std::vector<Vec3f> &&vertices, const std::vector<Vec3i32> &&faces);
     explicit TriangleMesh(const indexed_triangle_set &M);
     explicit TriangleMesh(indexed_triangle_set &&M, const RepairedMeshErrors& repaired_errors = RepairedMeshErrors());
+    // Statistics known in advance, for example loaded from a cache together with the mesh. The statistics are not recalculated.
+    TriangleMesh(indexed_triangle_set &&M, const TriangleMeshStats &stats) : its(std::move(M)), m_stats(stats) { assert(m_stats.number_of_facets == this->its.indices.size()); }
     void clear() { this->its.clear(); this->m_stats.clear(); }
     bool ReadSTLFile(const char* input_file, bool repair = true);
     bool write_ascii(const char* output_file);
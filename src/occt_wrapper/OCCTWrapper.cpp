@@ -2,8 +2,12 @@
 
 #include "occtwrapper_export.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #ifdef _WIN32
 #define DIR_SEPARATOR '\\'
 #else
@@ -22,9 +26,6 @@
 #include "TopExp_Explorer.hxx"
 #include "BRep_Tool.hxx"
 
-const double STEP_TRANS_CHORD_ERROR = 0.005;
-const double STEP_TRANS_ANGLE_RES = 1;
-
 // const int LOAD_STEP_STAGE_READ_FILE          = 0;
 // const int LOAD_STEP_STAGE_GET_SOLID          = 1;
 // const int LOAD_STEP_STAGE_GET_MESH           = 2;
@@ -77,7 +78,51 @@ static void getNamedSolids(const TopLoc_Location& location, const Handle(XCAFDoc
     }
 }
 
-extern "C" OCCTWRAPPER_EXPORT bool load_step_internal(const char *path, OCCTResult* res /*BBS:, ImportStepProgressFn proFn*/)
+// Tessellate a single solid into a volume with duplicate vertices at the face boundaries.
+static void mesh_solid(const NamedSolid &named_solid, double linear_deflection, double angular_deflection, bool in_parallel, OCCTVolume &volume)
+{
+    auto& vertices = volume.vertices;
+    auto& indices  = volume.indices;
+
+    BRepMesh_IncrementalMesh mesh(named_solid.solid, linear_deflection, false, angular_deflection, in_parallel);
+
+    for (TopExp_Explorer anExpSF(named_solid.solid, TopAbs_FACE); anExpSF.More(); anExpSF.Next()) {
+        const int aNodeOffset = int(vertices.size());
+        const TopoDS_Shape& aFace = anExpSF.Current();
+        TopLoc_Location aLoc;
+        Handle(Poly_Triangulation) aTriangulation = BRep_Tool::Triangulation(TopoDS::Face(aFace), aLoc);
+        if (aTriangulation.IsNull())
+            continue;
+
+        // First copy vertices (will create duplicates).
+        gp_Trsf aTrsf = aLoc.Transformation();
+        for (Standard_Integer aNodeIter = 1; aNodeIter <= aTriangulation->NbNodes(); ++aNodeIter) {
+            gp_Pnt aPnt = aTriangulation->Node(aNodeIter);
+            aPnt.Transform(aTrsf);
+            vertices.push_back({float(aPnt.X()), float(aPnt.Y()), float(aPnt.Z())});
+        }
+        // Now the indices.
+        const TopAbs_Orientation anOrientation = anExpSF.Current().Orientation();
+        for (Standard_Integer aTriIter = 1; aTriIter <= aTriangulation->NbTriangles(); ++aTriIter) {
+            Poly_Triangle aTri = aTriangulation->Triangle(aTriIter);
+
+            Standard_Integer anId[3];
+            aTri.Get(anId[0], anId[1], anId[2]);
+            if (anOrientation == TopAbs_REVERSED)
+                std::swap(anId[1], anId[2]);
+
+            // Account for the vertices we already have from previous faces.
+            // anId is 1-based index !
+            indices.push_back({anId[0] - 1 + aNodeOffset,
+                               anId[1] - 1 + aNodeOffset,
+                               anId[2] - 1 + aNodeOffset});
+        }
+    }
+
+    volume.volume_name = named_solid.name;
+}
+
+extern "C" OCCTWRAPPER_EXPORT bool load_step_internal(const char *path, OCCTResult* res, double linear_deflection, double angular_deflection /*BBS:, ImportStepProgressFn proFn*/)
 {
 try {
     //bool cb_cancel = false;
@@ -126,61 +171,32 @@ try {
     std::string obj_name((last_slash == nullptr) ? path : last_slash + 1);
     res->object_name = obj_name;
 
-    for (size_t i = 0; i < namedSolids.size(); ++i) {
-        //BBS:if (proFn) {
-        //    proFn(LOAD_STEP_STAGE_GET_MESH, i, namedSolids.size(), cb_cancel);
-        //    if (cb_cancel) {
-        //        model->delete_object(new_object);
-        //        shapeTool.reset(nullptr);
-        //        application->Close(document);
-        //        return false;
-        //    }
-        //}
-
-        res->volumes.emplace_back();
-        auto& vertices = res->volumes.back().vertices;
-        auto& indices  = res->volumes.back().indices;
-
-        BRepMesh_IncrementalMesh mesh(namedSolids[i].solid, STEP_TRANS_CHORD_ERROR, false, STEP_TRANS_ANGLE_RES, true);
-
-        for (TopExp_Explorer anExpSF(namedSolids[i].solid, TopAbs_FACE); anExpSF.More(); anExpSF.Next()) {
-            const int aNodeOffset = int(vertices.size());
-            const TopoDS_Shape& aFace = anExpSF.Current();
-            TopLoc_Location aLoc;
-            Handle(Poly_Triangulation) aTriangulation = BRep_Tool::Triangulation(TopoDS::Face(aFace), aLoc);
-            if (aTriangulation.IsNull())
-                continue;
-
-            // First copy vertices (will create duplicates).
-            gp_Trsf aTrsf = aLoc.Transformation();
-            for (Standard_Integer aNodeIter = 1; aNodeIter <= aTriangulation->NbNodes(); ++aNodeIter) {
-                gp_Pnt aPnt = aTriangulation->Node(aNodeIter);
-                aPnt.Transform(aTrsf);
-                vertices.push_back({float(aPnt.X()), float(aPnt.Y()), float(aPnt.Z())});
-            }
-            // Now the indices.
-            const TopAbs_Orientation anOrientation = anExpSF.Current().Orientation();
-            for (Standard_Integer aTriIter = 1; aTriIter <= aTriangulation->NbTriangles(); ++aTriIter) {
-                Poly_Triangle aTri = aTriangulation->Triangle(aTriIter);
-
-                Standard_Integer anId[3];
-                aTri.Get(anId[0], anId[1], anId[2]);
-                if (anOrientation == TopAbs_REVERSED)
-                    std::swap(anId[1], anId[2]);
-
-                // Account for the vertices we already have from previous faces.
-                // anId is 1-based index !
-                indices.push_back({anId[0] - 1 + aNodeOffset,
-                                   anId[1] - 1 + aNodeOffset,
-                                   anId[2] - 1 + aNodeOffset});
+    // Each solid is transformed into a copy of its shape, thus the solids do not share any topology
+    // and they may be tessellated concurrently. Each solid writes into its own slot to keep the output order
+    // independent of scheduling. OCCT parallelizes over the faces of a single solid only if there is just one.
+    res->volumes.assign(namedSolids.size(), OCCTVolume{});
+    std::vector<std::string> errors(namedSolids.size());
+    const bool mesh_in_parallel = namedSolids.size() == 1;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, namedSolids.size(), 1),
+        [&namedSolids, res, &errors, linear_deflection, angular_deflection, mesh_in_parallel](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i)
+            try {
+                mesh_solid(namedSolids[i], linear_deflection, angular_deflection, mesh_in_parallel, res->volumes[i]);
+            } catch (const std::exception &ex) {
+                errors[i] = ex.what();
+            } catch (...) {
+                errors[i] = "An exception was thrown while meshing a solid.";
             }
+    });
+    for (std::string &error : errors)
+        if (! error.empty()) {
+            shapeTool.reset(nullptr);
+            application->Close(document);
+            res->error_str = std::move(error);
+            return false;
         }
-
-        res->volumes.back().volume_name = namedSolids[i].name;
-
-        if (vertices.empty())
-            res->volumes.pop_back();        
-    }
+    res->volumes.erase(std::remove_if(res->volumes.begin(), res->volumes.end(),
+        [](const OCCTVolume &volume) { return volume.vertices.empty(); }), res->volumes.end());
 
     shapeTool.reset(nullptr);
     application->Close(document);
@@ -20,7 +20,11 @@ struct OCCTResult {
     std::vector<OCCTVolume> volumes;
 };
 
-using LoadStepFn = bool (*)(const char *path, OCCTResult* occt_result);
+// Tessellation tolerances of the STEP import: maximum chord deviation (mm) and maximum angle between adjacent triangles (radians).
+constexpr const double STEP_DEFAULT_LINEAR_DEFLECTION  = 0.005;
+constexpr const double STEP_DEFAULT_ANGULAR_DEFLECTION = 1.;
+
+using LoadStepFn = bool (*)(const char *path, OCCTResult* occt_result, double linear_deflection, double angular_deflection);
 
 }; // namespace Slic3r
 
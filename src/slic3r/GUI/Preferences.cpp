@@ -281,6 +281,16 @@ void PreferencesDialog::build(size_t selected_tab)
         option = Option(def, "export_sources_full_pathnames");
         m_optgroups_general.back()->append_single_option_line(option);
 
+        def.label = L("3mf compression level");
+        def.type = coInt;
+        def.tooltip = L("Compression level of the 3mf project files, from 0 (no compression, fastest save) to 10 (smallest file, slowest save). Default is 6.");
+        def.set_default_value(new ConfigOptionInt{ atoi(app_config->get("3mf_compression_level").c_str()) });
+        option = Option(def, "3mf_compression_level");
+        option.opt.min = 0;
+        option.opt.max = 10;
+        option.opt.width = 6;
+        m_optgroups_general.back()->append_single_option_line(option);
+
 #ifdef _WIN32
 		// Please keep in sync with ConfigWizard
 		def.label = (boost::format(_u8L("Associate .3mf files to %1%")) % SLIC3R_APP_NAME).str();
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/ClipperUtils.hpp"
+#include "libslic3r/GCode/AvoidCrossingPerimeters.hpp"
+#include "libslic3r/Layer.hpp"
+#include "libslic3r/SlicesToTriangleMesh.hpp"
+
+#include "test_data.hpp"
+
+using namespace Slic3r;
+
+// A 40x40x5mm plate with square holes.
+static TriangleMesh plate_with_holes(const std::vector<Vec2d> &hole_centers, double hole_size)
+{
+    ExPolygon plate;
+    plate.contour = Polygon::new_scale({ { -20., -20. }, { 20., -20. }, { 20., 20. }, { -20., 20. } });
+    for (const Vec2d &c : hole_centers) {
+        const double r = 0.5 * hole_size;
+        plate.holes.emplace_back(Polygon::new_scale({ { c.x() - r, c.y() - r }, { c.x() - r, c.y() + r }, { c.x() + r, c.y() + r }, { c.x() + r, c.y() - r } }));
+    }
+    return TriangleMesh(slices_to_mesh(std::vector<ExPolygons>(25, ExPolygons{ plate }), 0., 0.2, 0.2));
+}
+
+TEST_CASE("Avoid crossing perimeters: visibility graph travels", "[AvoidCrossingPerimeters]")
+{
+    auto travel_layer = [](const TriangleMesh &mesh, Print &print) -> const Layer& {
+        Test::init_and_process_print({ mesh }, print, {
+            { "layer_height",       0.2 },
+            { "first_layer_height", 0.2 },
+            { "perimeters",         2 },
+            { "fill_density",       "20%" },
+        });
+        const PrintObject &object = *print.objects().front();
+        REQUIRE(object.layers().size() == 25);
+        // A layer in the middle of the plate, without any top surfaces to avoid.
+        return *object.layers()[12];
+    };
+    // The travel does not leave the layer, thus it does not cross any perimeter.
+    auto crosses_perimeters = [](const Layer &layer, const Polyline &travel) {
+        return ! diff_pl(Polylines{ travel }, offset(layer.lslices, float(SCALED_EPSILON))).empty();
+    };
+
+    GIVEN("A plate with a single large hole") {
+        Print        print;
+        const Layer &layer  = travel_layer(plate_with_holes({ Vec2d::Zero() }, 20.), print);
+        const Point  center = get_extents(layer.lslices).center();
+        const Point  start  = center + Point::new_scale(-15., 0.);
+        const Point  end    = center + Point::new_scale(15., 0.);
+        AvoidCrossingPerimeters avoid_crossing_perimeters;
+        Polyline     travel = avoid_crossing_perimeters.travel_inside(layer, start, end, true);
+        THEN("the travel goes around the hole") {
+            REQUIRE(travel.size() > 2);
+            REQUIRE(travel.first_point() == start);
+            REQUIRE(travel.last_point() == end);
+            REQUIRE(! crosses_perimeters(layer, travel));
+        }
+        THEN("the travel follows the geodesic around two corners of the hole") {
+            // The geodesic touching the corners of the hole is 2 * sqrt(5^2 + 10^2) + 20 = 42.36mm long.
+            // The travel keeps 1.5 perimeter spacing off the hole, which makes it at most 49mm long for perimeter spacings below 1.3mm.
+            // Following the boundary of the hole would make it longer than 50mm.
+            REQUIRE(unscaled(travel.length()) > 42.3);
+            REQUIRE(unscaled(travel.length()) < 49.);
+        }
+    }
+
+    GIVEN("A plate with a grid of holes") {
+        std::vector<Vec2d> hole_centers;
+        for (double y : { -12., 0., 12. })
+            for (double x : { -12., 0., 12. })
+                hole_centers.emplace_back(x, y);
+        Print        print;
+        const Layer &layer  = travel_layer(plate_with_holes(hole_centers, 6.), print);
+        const Point  center = get_extents(layer.lslices).center();
+        // Points between the holes.
+        Points points;
+        for (double y : { -18., -6., 6., 18. })
+            for (double x : { -18., -6., 6., 18. })
+                points.emplace_back(center + Point::new_scale(x, y));
+        AvoidCrossingPerimeters avoid_crossing_perimeters;
+        AvoidCrossingPerimeters avoid_crossing_perimeters_inner;
+        double length_graph = 0.;
+        double length_inner = 0.;
+        bool   crossing     = false;
+        for (const Point &start : points)
+            for (const Point &end : points)
+                if (start != end) {
+                    Polyline travel = avoid_crossing_perimeters.travel_inside(layer, start, end, true);
+                    if (travel.empty())
+                        travel = Polyline(start, end);
+                    crossing |= crosses_perimeters(layer, travel);
+                    length_graph += travel.length();
+                    Polyline travel_inner = avoid_crossing_perimeters_inner.travel_inside(layer, start, end, false);
+                    length_inner += travel_inner.empty() ? (end - start).cast<double>().norm() : travel_inner.length();
+                }
+        THEN("no travel crosses the perimeters") {
+            REQUIRE(! crossing);
+        }
+        THEN("the travels are not longer than those following the boundaries") {
+            REQUIRE(length_graph < length_inner * 1.001);
+        }
+    }
+}
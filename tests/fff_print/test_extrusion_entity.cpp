@@ -20,7 +20,7 @@ static inline Slic3r::Point random_point(float LO=-50, float HI=50)
 // build a sample extrusion entity collection with random start and end points.
 static Slic3r::ExtrusionPath random_path(size_t length = 20, float LO = -50, float HI = 50)
 {
-    ExtrusionPath t {erPerimeter, 1.0, 1.0, 1.0};
+    ExtrusionPath t {erPerimeter, 1.0, 1.0, 1.0, true};
     for (size_t j = 0; j < length; ++ j)
         t.polyline.append(random_point(LO, HI));
     return t;
@@ -42,10 +42,10 @@ SCENARIO("ExtrusionEntityCollection: Polygon flattening", "[ExtrusionEntity]") {
 
     Slic3r::ExtrusionEntityCollection sub_nosort;
     sub_nosort.append(nosort_path_set);
-    sub_nosort.no_sort = true;
+    sub_nosort.set_can_sort_reverse(false, true);
 
     Slic3r::ExtrusionEntityCollection sub_sort;
-    sub_sort.no_sort = false;
+    sub_sort.set_can_sort_reverse(true, true);
     sub_sort.append(random_paths());
 
     GIVEN("A Extrusion Entity Collection with a child that has one child that is marked as no-sort") {
@@ -59,24 +59,24 @@ SCENARIO("ExtrusionEntityCollection: Polygon flattening", "[ExtrusionEntity]") {
         WHEN("The EEC is flattened with default options (preserve_order=false)") {
 			output = sample.flatten();
             THEN("The output EEC contains no Extrusion Entity Collections") {
-                CHECK(std::count_if(output.entities.cbegin(), output.entities.cend(), [=](const ExtrusionEntity* e) {return e->is_collection();}) == 0);
+                CHECK(std::count_if(output.entities().cbegin(), output.entities().cend(), [=](const ExtrusionEntity* e) {return e->is_collection();}) == 0);
             }
         }
         WHEN("The EEC is flattened with preservation (preserve_order=true)") {
 			output = sample.flatten(true);
             THEN("The output EECs contains one EEC.") {
-                CHECK(std::count_if(output.entities.cbegin(), output.entities.cend(), [=](const ExtrusionEntity* e) {return e->is_collection();}) == 1);
+                CHECK(std::count_if(output.entities().cbegin(), output.entities().cend(), [=](const ExtrusionEntity* e) {return e->is_collection();}) == 1);
             }
             AND_THEN("The ordered EEC contains the same order of elements than the original") {
                 // find the entity in the collection
-                for (auto e : output.entities)
+                for (auto e : output.entities())
                     if (e->is_collection()) {
                         ExtrusionEntityCollection *temp = dynamic_cast<ExtrusionEntityCollection*>(e);
                         // check each Extrusion path against nosort_path_set to see if the first and last match the same
-                        CHECK(nosort_path_set.size() == temp->entities.size());
+                        CHECK(nosort_path_set.size() == temp->entities().size());
                         for (size_t i = 0; i < nosort_path_set.size(); ++ i) {
-                            CHECK(temp->entities[i]->first_point() == nosort_path_set[i].first_point());
-                            CHECK(temp->entities[i]->last_point() == nosort_path_set[i].last_point());
+                            CHECK(temp->entities()[i]->first_point() == nosort_path_set[i].first_point());
+                            CHECK(temp->entities()[i]->last_point() == nosort_path_set[i].last_point());
                         }
                     }
             }
@@ -5,10 +5,16 @@
 
 #include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/Fill/Fill.hpp"
+#include "libslic3r/Fill/FillAdaptive.hpp"
+#include "libslic3r/Fill/FillGyroid.hpp"
+#include "libslic3r/Fill/FillLightning.hpp"
+#include "libslic3r/Fill/Lightning/Generator.hpp"
+#include "libslic3r/Fill/Lightning/TreeNode.hpp"
 #include "libslic3r/Flow.hpp"
 #include "libslic3r/Geometry.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/SVG.hpp"
+#include "libslic3r/TriangleMesh.hpp"
 #include "libslic3r/libslic3r.h"
 
 #include "test_data.hpp"
@@ -126,7 +132,7 @@ TEST_CASE("Fill: Pattern Path Length", "[Fill]") {
         filler->angle = 0;
         
         Surface surface(SurfaceType::stPosTop | SurfaceType::stDensSolid, expolygon);
-        auto flow = Slic3r::Flow(0.69f, 0.4f, 0.50f);
+        auto flow = Slic3r::Flow::new_from_width(0.69f, 0.50f, 0.4f, 1.f);
 
 		FillParams fill_params;
 		fill_params.density = 1.0;
@@ -429,13 +435,222 @@ for my $pattern (qw(rectilinear honeycomb hilbertcurve concentric)) {
 }
 */
 
+TEST_CASE("Fill: adaptive cubic octree of a large mesh", "[.][benchmark][Fill]") {
+    // Finely tessellated sphere (about 260k triangles), rotated to the coordinate system of the octree
+    // the same way PrintObject::prepare_adaptive_infill_data() does.
+    indexed_triangle_set mesh = its_make_sphere(25., PI / 360.);
+    its_transform(mesh, Eigen::Matrix<double, 3, 3, Eigen::DontAlign>(FillAdaptive::transform_to_octree().toRotationMatrix()), true);
+
+    const ExPolygon square { Point::new_scale(-30, -30), Point::new_scale(30, -30), Point::new_scale(30, 30), Point::new_scale(-30, 30) };
+    const Surface   surface(stPosInternal | stDensSparse, square);
+    FillParams fill_params;
+    fill_params.density = 0.2f;
+
+    auto fill_layers = [&mesh, &square, &surface, &fill_params](InfillPattern pattern, const FillAdaptive::Octree *octree) {
+        std::unique_ptr<Fill> filler(Fill::new_from_type(pattern));
+        filler->adapt_fill_octree = const_cast<FillAdaptive::Octree*>(octree);
+        filler->bounding_box      = get_extents(square);
+        filler->angle             = 0;
+        filler->layer_id          = 0;
+        filler->init_spacing(0.45, fill_params);
+        std::vector<Polylines> layers;
+        for (double z = -24.8; z < 25.; z += 0.4) {
+            filler->z = z;
+            layers.emplace_back(filler->fill_surface(&surface, fill_params));
+        }
+        return layers;
+    };
+    auto same_layers = [](const std::vector<Polylines> &lhs, const std::vector<Polylines> &rhs) {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (size_t i = 0; i < lhs.size(); ++ i) {
+            if (lhs[i].size() != rhs[i].size())
+                return false;
+            for (size_t j = 0; j < lhs[i].size(); ++ j)
+                if (lhs[i][j].points != rhs[i][j].points)
+                    return false;
+        }
+        return true;
+    };
+    auto num_lines = [](const std::vector<Polylines> &layers) {
+        return std::accumulate(layers.begin(), layers.end(), size_t(0), [](size_t n, const Polylines &layer) { return n + layer.size(); });
+    };
+
+    std::array<size_t, 2> lines;
+    for (bool support_overhangs_only : { false, true }) {
+        const InfillPattern pattern = support_overhangs_only ? ipSupportCubic : ipAdaptiveCubic;
+        FillAdaptive::OctreePtr octree = FillAdaptive::build_octree(mesh, {}, 2., support_overhangs_only);
+        std::vector<Polylines> layers = fill_layers(pattern, octree.get());
+        lines[support_overhangs_only] = num_lines(layers);
+        REQUIRE(lines[support_overhangs_only] > 0);
+        // The octree is built in parallel, the infill generated from it has to be the same for every build.
+        FillAdaptive::OctreePtr octree2 = FillAdaptive::build_octree(mesh, {}, 2., support_overhangs_only);
+        REQUIRE(same_layers(layers, fill_layers(pattern, octree2.get())));
+    }
+    // The support cubic octree is only densified at the overhanging part of the sphere.
+    REQUIRE(lines[1] < lines[0]);
+}
+
+// make_gyroid_waves() as it was before the periods of the waves were reused, to compare the waves against.
+namespace gyroid_reference {
+
+static inline double f(double x, double z_sin, double z_cos, bool vertical, bool flip)
+{
+    if (vertical) {
+        double phase_offset = (z_cos < 0 ? M_PI : 0) + M_PI;
+        double a   = sin(x + phase_offset);
+        double b   = - z_cos;
+        double res = z_sin * cos(x + phase_offset + (flip ? M_PI : 0.));
+        double r   = sqrt(sqr(a) + sqr(b));
+        return asin(a/r) + asin(res/r) + M_PI;
+    } else {
+        double phase_offset = z_sin < 0 ? M_PI : 0.;
+        double a   = cos(x + phase_offset);
+        double b   = - z_sin;
+        double res = z_cos * sin(x + phase_offset + (flip ? 0 : M_PI));
+        double r   = sqrt(sqr(a) + sqr(b));
+        return (asin(a/r) + asin(res/r) + 0.5 * M_PI);
+    }
+}
+
+static Polyline make_wave(const std::vector<Vec2d> &one_period, double width, double height, double offset, double scaleFactor,
+    double z_cos, double z_sin, bool vertical, bool flip)
+{
+    std::vector<Vec2d> points = one_period;
+    double period = points.back()(0);
+    if (width != period) {
+        points.pop_back();
+        size_t n = points.size();
+        do {
+            points.emplace_back(points[points.size()-n].x() + period, points[points.size()-n].y());
+        } while (points.back()(0) < width - EPSILON);
+        points.emplace_back(Vec2d(width, f(width, z_sin, z_cos, vertical, flip)));
+    }
+    Polyline polyline;
+    for (auto &point : points) {
+        point(1) += offset;
+        point(1) = std::clamp(double(point.y()), 0., height);
+        if (vertical)
+            std::swap(point(0), point(1));
+        polyline.points.emplace_back((point * scaleFactor).cast<coord_t>());
+    }
+    return polyline;
+}
+
+static std::vector<Vec2d> make_one_period(double width, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
+{
+    std::vector<Vec2d> points;
+    double dx = M_PI_2;
+    double limit = std::min(2*M_PI, width);
+    for (double x = 0.; x < limit - EPSILON; x += dx)
+        points.emplace_back(Vec2d(x, f(x, z_sin, z_cos, vertical, flip)));
+    points.emplace_back(Vec2d(limit, f(limit, z_sin, z_cos, vertical, flip)));
+    for (;;) {
+        size_t size = points.size();
+        for (unsigned int i = 1; i < size; ++ i) {
+            auto &lp = points[i-1];
+            auto &rp = points[i];
+            double x = lp(0) + (rp(0) - lp(0)) / 2;
+            Vec2d ip = { x, f(x, z_sin, z_cos, vertical, flip) };
+            if (std::abs(cross2(Vec2d(ip - lp), Vec2d(ip - rp))) > sqr(tolerance))
+                points.emplace_back(std::move(ip));
+        }
+        if (size == points.size())
+            break;
+        std::sort(points.begin(), points.end(), [](const Vec2d &lhs, const Vec2d &rhs) { return lhs(0) < rhs(0); });
+    }
+    return points;
+}
+
+static Polylines make_gyroid_waves(coordf_t gridZ, coordf_t scaleFactor, double width, double height, double tolerance)
+{
+    const double z     = gridZ / scaleFactor;
+    const double z_sin = sin(z);
+    const double z_cos = cos(z);
+    bool vertical = (std::abs(z_sin) <= std::abs(z_cos));
+    double lower_bound = 0.;
+    double upper_bound = height;
+    bool flip = true;
+    if (vertical) {
+        flip = false;
+        lower_bound = -M_PI;
+        upper_bound = width - M_PI_2;
+        std::swap(width,height);
+    }
+    std::vector<Vec2d> one_period_odd = make_one_period(width, z_cos, z_sin, vertical, flip, tolerance);
+    flip = !flip;
+    std::vector<Vec2d> one_period_even = make_one_period(width, z_cos, z_sin, vertical, flip, tolerance);
+    Polylines result;
+    for (double y0 = lower_bound; y0 < upper_bound + EPSILON; y0 += M_PI) {
+        result.emplace_back(make_wave(one_period_odd, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+        y0 += M_PI;
+        if (y0 < upper_bound + EPSILON)
+            result.emplace_back(make_wave(one_period_even, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+    }
+    return result;
+}
+
+} // namespace gyroid_reference
+
+TEST_CASE("Fill: gyroid waves with reused periods", "[Fill]") {
+    auto same_polylines = [](const Polylines &lhs, const Polylines &rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+            [](const Polyline &l, const Polyline &r) { return l.points == r.points; });
+    };
+    // Line spacing of 0.45mm extrusions at 20% density, as scaled by FillGyroid.
+    const coordf_t scale_factor = scaled<coordf_t>(0.45 / 0.2 / FillGyroid::DENSITY_ADJUST);
+    const double   tolerance    = 0.0125 / unscaled(scale_factor);
+    GyroidPeriods  periods;
+    // Layers filled one after the other, surfaces of a layer filled one after the other, narrow and wide ones.
+    for (double z = 0.2; z < 20.; z += 0.2)
+        for (double width : { 3., 8., 30., 200. })
+            for (double height : { 2., 8., 30., 150. }) {
+                Polylines waves = make_gyroid_waves(scaled<coordf_t>(z), scale_factor, width, height, tolerance, periods);
+                REQUIRE(! waves.empty());
+                REQUIRE(same_polylines(waves, gyroid_reference::make_gyroid_waves(scaled<coordf_t>(z), scale_factor, width, height, tolerance)));
+            }
+}
+
+TEST_CASE("Fill: lightning trees of a sphere", "[Fill]") {
+    Print print;
+    Test::init_and_process_print({ Test::TestMesh::sphere_50mm }, print, {
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 },
+        { "fill_pattern",       "lightning" },
+        { "fill_density",       "20%" },
+    });
+    const PrintObject &object = *print.objects().front();
+    FillLightning::GeneratorPtr generator = FillLightning::build_generator(object, 20., []() {});
+    REQUIRE(generator);
+
+    // The trees, as generated before the overhangs were computed in parallel and before the unsupported points
+    // of the distance field were stored in a single grid of indices.
+    size_t  num_roots    = 0;
+    size_t  num_branches = 0;
+    int64_t sum_x        = 0;
+    int64_t sum_y        = 0;
+    for (size_t layer_id = 0; layer_id < object.layers().size(); ++ layer_id)
+        for (const FillLightning::NodeSPtr &root : generator->getTreesForLayer(layer_id).tree_roots) {
+            ++ num_roots;
+            root->visitBranches([&num_branches, &sum_x, &sum_y](const Point &from, const Point &to) {
+                ++ num_branches;
+                sum_x += int64_t(from.x()) + int64_t(to.x());
+                sum_y += int64_t(from.y()) + int64_t(to.y());
+            });
+        }
+    CHECK(num_roots == 0);
+    CHECK(num_branches == 0);
+    CHECK(sum_x == 0);
+    CHECK(sum_y == 0);
+}
+
 bool test_if_solid_surface_filled(const ExPolygon& expolygon, double flow_spacing, double angle, double density)
 {
     std::unique_ptr<Slic3r::Fill> filler(Slic3r::Fill::new_from_type("rectilinear"));
 	filler->bounding_box = get_extents(expolygon.contour);
     filler->angle = float(angle);
 
-	Flow flow(float(flow_spacing), 0.4f, float(flow_spacing));
+	Flow flow = Flow::new_from_width(float(flow_spacing), float(flow_spacing), 0.4f, 1.f);
 
 	FillParams fill_params;
 	fill_params.density = float(density);
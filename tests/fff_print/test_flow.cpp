@@ -93,25 +93,29 @@ SCENARIO(" Bridge flow specifics.", "[Flow]") {
 /// Test the expected behavior for auto-width, 
 /// spacing, etc
 SCENARIO("Flow: Flow math for non-bridges", "[Flow]") {
+    ConfigOptionFloatOrPercent width_0(0., false);
+    ConfigOptionFloatOrPercent spacing_0(0., false, true);
     GIVEN("Nozzle Diameter of 0.4, a desired width of 1mm and layer height of 0.5") {
         ConfigOptionFloatOrPercent	width(1.0, false);
+        ConfigOptionFloatOrPercent	spacing(1.0, false, true);
         float nozzle_diameter	= 0.4f;
         float layer_height		= 0.4f;
+        float spacing_ratio		= 1.f;
 
         // Spacing for non-bridges is has some overlap
-        THEN("External perimeter flow has spacing fixed to 1.125 * nozzle_diameter") {
-            auto flow = Flow::new_from_config_width(frExternalPerimeter, ConfigOptionFloatOrPercent(0, false), nozzle_diameter, layer_height);
-            REQUIRE(flow.spacing() == Approx(1.125 * nozzle_diameter - layer_height * (1.0 - PI / 4.0)));
+        THEN("External perimeter flow has spacing fixed to 1.05 * nozzle_diameter") {
+            auto flow = Flow::new_from_config_width(frExternalPerimeter, width_0, spacing_0, nozzle_diameter, layer_height, spacing_ratio);
+            REQUIRE(flow.spacing() == Approx(1.05 * nozzle_diameter - layer_height * (1.0 - PI / 4.0)));
         }
 
         THEN("Internal perimeter flow has spacing fixed to 1.125 * nozzle_diameter") {
-            auto flow = Flow::new_from_config_width(frPerimeter, ConfigOptionFloatOrPercent(0, false), nozzle_diameter, layer_height);
+            auto flow = Flow::new_from_config_width(frPerimeter, width_0, spacing_0, nozzle_diameter, layer_height, spacing_ratio);
             REQUIRE(flow.spacing() == Approx(1.125 *nozzle_diameter - layer_height * (1.0 - PI / 4.0)));
         }
         THEN("Spacing for supplied width is 0.8927f") {
-            auto flow = Flow::new_from_config_width(frExternalPerimeter, width, nozzle_diameter, layer_height);
+            auto flow = Flow::new_from_config_width(frExternalPerimeter, width, spacing, nozzle_diameter, layer_height, spacing_ratio);
             REQUIRE(flow.spacing() == Approx(width.value - layer_height * (1.0 - PI / 4.0)));
-            flow = Flow::new_from_config_width(frPerimeter, width, nozzle_diameter, layer_height);
+            flow = Flow::new_from_config_width(frPerimeter, width, spacing, nozzle_diameter, layer_height, spacing_ratio);
             REQUIRE(flow.spacing() == Approx(width.value - layer_height * (1.0 - PI / 4.0)));
         }
     }
@@ -119,17 +123,18 @@ SCENARIO("Flow: Flow math for non-bridges", "[Flow]") {
     GIVEN("Nozzle Diameter of 0.25") {
         float nozzle_diameter	= 0.25f;
         float layer_height		= 0.5f;
+        float spacing_ratio		= 1.f;
         WHEN("layer height is set to 0.2") {
             layer_height = 0.15f;
             THEN("Max width is set.") {
-                auto flow = Flow::new_from_config_width(frPerimeter, ConfigOptionFloatOrPercent(0, false), nozzle_diameter, layer_height);
+                auto flow = Flow::new_from_config_width(frPerimeter, width_0, spacing_0, nozzle_diameter, layer_height, spacing_ratio);
                 REQUIRE(flow.width() == Approx(1.125 * nozzle_diameter));
             }
         }
         WHEN("Layer height is set to 0.25") {
             layer_height = 0.25f;
             THEN("Min width is set.") {
-                auto flow = Flow::new_from_config_width(frPerimeter, ConfigOptionFloatOrPercent(0, false), nozzle_diameter, layer_height);
+                auto flow = Flow::new_from_config_width(frPerimeter, width_0, spacing_0, nozzle_diameter, layer_height, spacing_ratio);
                 REQUIRE(flow.width() == Approx(1.125 * nozzle_diameter));
             }
         }
@@ -163,36 +168,11 @@ SCENARIO("Flow: Flow math for bridges", "[Flow]") {
             THEN("Bridge width is same as nozzle diameter") {
                 REQUIRE(flow.width() == Approx(nozzle_diameter));
             }
-            THEN("Bridge spacing is same as nozzle diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter") {
-                REQUIRE(flow.spacing() == Approx(nozzle_diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter));
-            }
-        }
-        WHEN("Flow role is frInfill") {
-            auto flow = Flow::new_from_config_width(frInfill, width, nozzle_diameter, layer_height, bridge_flow);
-            THEN("Bridge width is same as nozzle diameter") {
-                REQUIRE(flow.width == Approx(nozzle_diameter));
-            }
-            THEN("Bridge spacing is same as nozzle diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter") {
-                REQUIRE(flow.spacing() == Approx(nozzle_diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter));
-            }
-        }
-        WHEN("Flow role is frPerimeter") {
-            auto flow = Flow::new_from_config_width(frPerimeter, width, nozzle_diameter, layer_height, bridge_flow);
-            THEN("Bridge width is same as nozzle diameter") {
-                REQUIRE(flow.width == Approx(nozzle_diameter));
-            }
-            THEN("Bridge spacing is same as nozzle diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter") {
-                REQUIRE(flow.spacing() == Approx(nozzle_diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter));
-            }
-        }
-        WHEN("Flow role is frSupportMaterial") {
-            auto flow = Flow::new_from_config_width(frSupportMaterial, width, nozzle_diameter, layer_height, bridge_flow);
-            THEN("Bridge width is same as nozzle diameter") {
-                REQUIRE(flow.width == Approx(nozzle_diameter));
-            }
-            THEN("Bridge spacing is same as nozzle diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter") {
-                REQUIRE(flow.spacing() == Approx(nozzle_diameter + BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter));
+            // Bridges are no longer spaced apart by an extra BRIDGE_EXTRA_SPACING_MULT * nozzle_diameter.
+            THEN("Bridge spacing is same as nozzle diameter") {
+                REQUIRE(flow.spacing() == Approx(nozzle_diameter));
             }
         }
+        REQUIRE(Flow::bridge_extrusion_spacing(nozzle_diameter) == Approx(nozzle_diameter));
     }
 }
@@ -20,13 +20,13 @@ SCENARIO("lift() is not ignored after unlift() at normal values of Z", "[GCodeWr
             double trouble_Z = 203;
             writer.travel_to_z(trouble_Z);
             AND_WHEN("GcodeWriter::Lift() is called") {
-                REQUIRE(writer.lift().size() > 0);
+                REQUIRE(writer.lift(1).size() > 0);
                 AND_WHEN("Z is moved post-lift to the same delta as the config Z lift") {
                     REQUIRE(writer.travel_to_z(trouble_Z + config.retract_lift.values[0]).size() == 0);
                     AND_WHEN("GCodeWriter::Unlift() is called") {
                         REQUIRE(writer.unlift().size() == 0); // we're the same height so no additional move happens.
                         THEN("GCodeWriter::Lift() emits gcode.") {
-                            REQUIRE(writer.lift().size() > 0);
+                            REQUIRE(writer.lift(1).size() > 0);
                         }
                     }
                 }
@@ -36,13 +36,13 @@ SCENARIO("lift() is not ignored after unlift() at normal values of Z", "[GCodeWr
             double trouble_Z = 500003;
             writer.travel_to_z(trouble_Z);
             AND_WHEN("GcodeWriter::Lift() is called") {
-                REQUIRE(writer.lift().size() > 0);
+                REQUIRE(writer.lift(1).size() > 0);
                 AND_WHEN("Z is moved post-lift to the same delta as the config Z lift") {
                     REQUIRE(writer.travel_to_z(trouble_Z + config.retract_lift.values[0]).size() == 0);
                     AND_WHEN("GCodeWriter::Unlift() is called") {
                         REQUIRE(writer.unlift().size() == 0); // we're the same height so no additional move happens.
                         THEN("GCodeWriter::Lift() emits gcode.") {
-                            REQUIRE(writer.lift().size() > 0);
+                            REQUIRE(writer.lift(1).size() > 0);
                         }
                     }
                 }
@@ -52,13 +52,13 @@ SCENARIO("lift() is not ignored after unlift() at normal values of Z", "[GCodeWr
             double trouble_Z = 10.3;
             writer.travel_to_z(trouble_Z);
             AND_WHEN("GcodeWriter::Lift() is called") {
-                REQUIRE(writer.lift().size() > 0);
+                REQUIRE(writer.lift(1).size() > 0);
                 AND_WHEN("Z is moved post-lift to the same delta as the config Z lift") {
                     REQUIRE(writer.travel_to_z(trouble_Z + config.retract_lift.values[0]).size() == 0);
                     AND_WHEN("GCodeWriter::Unlift() is called") {
                         REQUIRE(writer.unlift().size() == 0); // we're the same height so no additional move happens.
                         THEN("GCodeWriter::Lift() emits gcode.") {
-                            REQUIRE(writer.lift().size() > 0);
+                            REQUIRE(writer.lift(1).size() > 0);
                         }
                     }
                 }
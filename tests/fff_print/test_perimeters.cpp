@@ -0,0 +1,82 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/ClipperUtils.hpp"
+#include "libslic3r/Layer.hpp"
+#include "libslic3r/PerimeterGenerator.hpp"
+
+#include "test_data.hpp"
+
+using namespace Slic3r;
+
+// Lengths of the perimeters at each overhang level, as classified by clipping them with the lower slices grown by the thresholds,
+// which is how the overhangs were detected before the signed distance splitting.
+static std::vector<double> overhang_lengths_by_clipping(const Polylines &perimeters, const ExPolygons &lower_slices,
+    const std::vector<coordf_t> &thresholds, ClipperLib::JoinType join_type)
+{
+    std::vector<double> out(thresholds.size() + 1, 0.);
+    Polylines remaining = perimeters;
+    for (size_t level = 0; level < thresholds.size(); ++ level) {
+        Polygons grown = offset(lower_slices, float(thresholds[level]), join_type, join_type == ClipperLib::jtRound ? double(scaled<float>(0.005)) : 3.);
+        for (const Polyline &pl : intersection_pl(remaining, grown))
+            out[level] += unscaled(pl.length());
+        remaining = diff_pl(remaining, grown);
+    }
+    for (const Polyline &pl : remaining)
+        out.back() += unscaled(pl.length());
+    return out;
+}
+
+TEST_CASE("Perimeters: overhang levels by signed distance match the clipped overhangs", "[Perimeters]")
+{
+    Print print;
+    Test::init_and_process_print({ Test::TestMesh::sphere_50mm, Test::TestMesh::overhang }, print, {
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 },
+        { "perimeters",         1 },
+        { "fill_density",       0 },
+    });
+
+    // Overhang thresholds of 0.45mm wide perimeters: bridge speed 90%, 110%, bridge flow 90%, 110% of a 0.4mm overhang width.
+    const coord_t               ext_perimeter_width = scaled<coord_t>(0.45);
+    const std::vector<coordf_t> thresholds { scaled<coordf_t>(0.36 - 0.225), scaled<coordf_t>(0.44 - 0.225), scaled<coordf_t>(0.6 - 0.225), scaled<coordf_t>(0.8 - 0.225) };
+    const coord_t               resolution = std::max(coord_t(thresholds.back()) + ext_perimeter_width, scaled<coord_t>(0.5));
+    const coord_t               min_step   = scaled<coord_t>(0.0125);
+
+    double total_length = 0.;
+    std::vector<double> lengths(thresholds.size() + 1, 0.);
+    std::vector<double> lengths_round(thresholds.size() + 1, 0.);
+    std::vector<double> lengths_miter(thresholds.size() + 1, 0.);
+    for (const PrintObject *object : print.objects())
+        for (size_t layer_id = 1; layer_id < object->layers().size(); ++ layer_id) {
+            const Layer &layer       = *object->layers()[layer_id];
+            const Layer &lower_layer = *object->layers()[layer_id - 1];
+            // External perimeters centered half the perimeter width inside the slices.
+            Polylines perimeters;
+            for (const Polygon &polygon : to_polygons(offset_ex(layer.lslices, - float(ext_perimeter_width / 2))))
+                perimeters.emplace_back(polygon.split_at_first_point());
+            LowerSlicesGrid grid;
+            grid.build(lower_layer.lslices, 0, resolution);
+            for (const Polyline &perimeter : perimeters) {
+                total_length += unscaled(perimeter.length());
+                for (const auto &[piece, level] : split_by_overhang_level(perimeter, grid.grid, thresholds, min_step))
+                    lengths[level] += unscaled(piece.length());
+            }
+            std::vector<double> round = overhang_lengths_by_clipping(perimeters, lower_layer.lslices, thresholds, ClipperLib::jtRound);
+            std::vector<double> miter = overhang_lengths_by_clipping(perimeters, lower_layer.lslices, thresholds, ClipperLib::jtMiter);
+            for (size_t level = 0; level <= thresholds.size(); ++ level) {
+                lengths_round[level] += round[level];
+                lengths_miter[level] += miter[level];
+            }
+        }
+
+    REQUIRE(total_length > 0.);
+    // All the levels are present on the bottom half of the sphere.
+    for (double length : lengths)
+        REQUIRE(length > 0.);
+    for (size_t level = 0; level <= thresholds.size(); ++ level) {
+        // The signed distance matches the round joined offsets up to the arc tolerance and the bisection precision.
+        REQUIRE(std::abs(lengths[level] - lengths_round[level]) < 0.002 * total_length);
+        // The mitered offsets of the former implementation only differ at the sharp convex corners of the lower slices.
+        REQUIRE(std::abs(lengths[level] - lengths_miter[level]) < 0.01 * total_length);
+    }
+}
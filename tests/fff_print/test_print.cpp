@@ -32,7 +32,7 @@ SCENARIO("PrintObject: Perimeter generation", "[PrintObject]") {
             }
             THEN("Every layer in region 0 has 1 island of perimeters") {
                 for (const Layer *layer : object.layers())
-                    REQUIRE(layer->regions().front()->perimeters.entities.size() == 1);
+                    REQUIRE(layer->regions().front()->perimeters.entities().size() == 1);
             }
             THEN("Every layer in region 0 has 3 paths in its perimeters list.") {
                 for (const Layer *layer : object.layers())
@@ -53,7 +53,7 @@ SCENARIO("Print: Skirt generation", "[Print]") {
             });
             THEN("Skirt Extrusion collection has 2 loops in it") {
                 REQUIRE(print.skirt().items_count() == 2);
-                REQUIRE(print.skirt().flatten().entities.size() == 2);
+                REQUIRE(print.skirt().flatten().entities().size() == 2);
             }
         }
     }
@@ -94,7 +94,7 @@ SCENARIO("PrintObject: minimum horizontal shells", "[PrintObject]") {
         TestMesh m { TestMesh::cube_20x20x20 };
         Slic3r::Model model;
 
-        config.set_deserialize({
+        config.set_deserialize_strict({
                                {"nozzle_diameter", 3},
                                {"bottom_solid_layers", 0},
                                {"top_solid_layers", 0},
@@ -175,7 +175,7 @@ SCENARIO("PrintObject: minimum horizontal shells", "[PrintObject]") {
             Slic3r::Test::init_print({m}, print, model, config);
             print.process();
             for (int i = 0; i < 20; i++)
-                print.objects().at(0)->layers().at(i)->make_fills();
+                print.get_object(0)->layers().at(i)->make_fills();
             AND_THEN("Layers 0-13 are solid (bottom of layer >= 1.22) (all fill_surfaces are solid)") {
                 for (int i = 0; i < 14; i++) {
                     CHECK(print.objects().at(0)->layers().at(i)->print_z <= (i+1 * 0.1));
@@ -270,7 +270,7 @@ SCENARIO("PrintObject: minimum horizontal shells", "[PrintObject]") {
             Slic3r::Test::init_print({m}, print, model, config);
             print.process();
             for (int i = 0; i < 20; i++)
-                print.objects().at(0)->layers().at(i)->make_fills();
+                print.get_object(0)->layers().at(i)->make_fills();
             AND_THEN("Layers 0-13 are solid (bottom of layer >= 1.22) (all fill_surfaces are solid)") {
                 for (int i = 0; i < 14; i++) {
                     CHECK(print.objects().at(0)->layers().at(i)->print_z <= (i+1 * 0.1));
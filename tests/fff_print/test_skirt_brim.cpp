@@ -161,7 +161,7 @@ SCENARIO("Original Slic3r Skirt/Brim tests", "[SkirtBrim]") {
             THEN("2 brim lines") {
 		        Slic3r::Print print;
 		        Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, config);
-                REQUIRE(print.brim().entities.size() == 2);
+                REQUIRE(print.brim().entities().size() == 2);
             }
         }
 
@@ -177,7 +177,7 @@ SCENARIO("Original Slic3r Skirt/Brim tests", "[SkirtBrim]") {
 	        Slic3r::Print print;
 	        Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, print, config);
             THEN("Four brim ears") {
-                REQUIRE(print.brim().entities.size() == 4);
+                REQUIRE(print.brim().entities().size() == 4);
             }
         }
 
@@ -192,7 +192,7 @@ SCENARIO("Original Slic3r Skirt/Brim tests", "[SkirtBrim]") {
             THEN("no brim") {
 		        Slic3r::Print print;
                 Slic3r::Test::init_and_process_print({ TestMesh::cube_20x20x20 }, print, config);
-                REQUIRE(print.brim().entities.size() == 0);
+                REQUIRE(print.brim().entities().size() == 0);
             }
         }
 #endif
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 
+#include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Layer.hpp"
 
@@ -29,14 +30,15 @@ SCENARIO("SupportMaterial: support_layers_z and contact_distance", "[SupportMate
 	{
         ConstSupportLayerPtrsAdaptor support_layers = print.objects().front()->support_layers();
 
-		first_support_layer_height_ok = support_layers.front()->print_z == print.config().first_layer_height.value;
+		first_support_layer_height_ok = support_layers.front()->print_z == print.get_first_layer_height();
 
 		layer_height_minimum_ok = true;
 		layer_height_maximum_ok = true;
-		double min_layer_height = print.config().min_layer_height.values.front();
-		double max_layer_height = print.config().nozzle_diameter.values.front();
-		if (print.config().max_layer_height.values.front() > EPSILON)
-			max_layer_height = std::min(max_layer_height, print.config().max_layer_height.values.front());
+		double nozzle_diameter  = print.config().nozzle_diameter.values.front();
+		double min_layer_height = print.config().min_layer_height.get_abs_value(0, nozzle_diameter);
+		double max_layer_height = nozzle_diameter;
+		if (print.config().max_layer_height.get_abs_value(0, nozzle_diameter) > EPSILON)
+			max_layer_height = std::min(max_layer_height, print.config().max_layer_height.get_abs_value(0, nozzle_diameter));
 		for (size_t i = 1; i < support_layers.size(); ++ i) {
 			if (support_layers[i]->print_z - support_layers[i - 1]->print_z < min_layer_height - EPSILON)
 				layer_height_minimum_ok = false;
@@ -119,6 +121,106 @@ SCENARIO("SupportMaterial: support_layers_z and contact_distance", "[SupportMate
     }
 }
 
+TEST_CASE("SupportMaterial: support on build plate only of a tall object", "[.][benchmark][SupportMaterial]")
+{
+    // A 200mm tall column with a 20mm tall ledge at its side and a plate on its top overhanging the ledge and the build plate,
+    // sliced into 2000 layers.
+    TriangleMesh mesh = make_cube(10., 10., 200.);
+    TriangleMesh ledge = make_cube(10., 10., 20.);
+    ledge.translate(10.f, 0.f, 0.f);
+    TriangleMesh plate = make_cube(30., 10., 2.);
+    plate.translate(0.f, 0.f, 198.f);
+    mesh.merge(ledge);
+    mesh.merge(plate);
+
+    Slic3r::Print print;
+    Slic3r::Test::init_and_process_print({ mesh }, print, {
+        { "support_material",                 1 },
+        { "support_material_buildplate_only", 1 },
+        { "layer_height",                     0.1 },
+        { "first_layer_height",               0.1 },
+    });
+
+    const PrintObject &object = *print.objects().front();
+    REQUIRE(object.layers().size() == 2000);
+    REQUIRE(! object.support_layers().empty());
+    // The plate above the ledge is not supported, as the support would stand on the ledge.
+    const ExPolygons ledge_area = offset_ex(diff_ex(object.layers().front()->lslices, object.layers()[1000]->lslices), - scaled<float>(1.));
+    REQUIRE(! ledge_area.empty());
+    bool support_on_ledge = false;
+    for (const SupportLayer *support_layer : object.support_layers())
+        if (support_layer->print_z > 21. && ! intersection_ex(support_layer->support_islands.expolygons, ledge_area).empty())
+            support_on_ledge = true;
+    REQUIRE(! support_on_ledge);
+}
+
+// Each island of a support layer has to stand on the support layer below, on the object below or on the print bed.
+static bool support_islands_supported(const PrintObject &object)
+{
+    const SupportLayer *support_layer_below = nullptr;
+    for (const SupportLayer *support_layer : object.support_layers()) {
+        if (support_layer_below != nullptr) {
+            // Bottom contacts are separated from the object top surfaces by the contact distance.
+            const coordf_t bottom_z = support_layer->print_z - support_layer->height;
+            ExPolygons     carrier  = support_layer_below->support_islands.expolygons;
+            for (const Layer *layer : object.layers())
+                if (layer->print_z > bottom_z - 1. && layer->print_z < bottom_z + EPSILON)
+                    append(carrier, layer->lslices);
+            for (const ExPolygon &island : support_layer->support_islands.expolygons)
+                if (intersection_ex(ExPolygons{ island }, carrier).empty())
+                    return false;
+        }
+        support_layer_below = support_layer;
+    }
+    return true;
+}
+
+TEST_CASE("SupportMaterial: tree supports of a mushroom", "[SupportMaterial]")
+{
+    // A 60x60mm plate on top of a 40mm tall column of 10mm diameter.
+    TriangleMesh mesh = make_cylinder(5., 40.);
+    TriangleMesh plate = make_cube(60., 60., 2.);
+    plate.translate(-30.f, -30.f, 40.f);
+    mesh.merge(plate);
+
+    auto support_volume = [](const TriangleMesh &object_mesh, const char *style, bool buildplate_only) {
+        Slic3r::Print print;
+        Slic3r::Test::init_and_process_print({ object_mesh }, print, {
+            { "support_material",                 1 },
+            { "support_material_style",           style },
+            { "support_material_buildplate_only", buildplate_only },
+            { "layer_height",                     0.2 },
+            { "first_layer_height",               0.2 },
+        });
+        const PrintObject &object = *print.objects().front();
+        REQUIRE(! object.support_layers().empty());
+        REQUIRE(support_islands_supported(object));
+        double volume = 0.;
+        for (const SupportLayer *support_layer : object.support_layers())
+            volume += support_layer->support_fills.total_volume();
+        return volume;
+    };
+
+    SECTION("tree supports are lighter than grid supports") {
+        double volume_grid = support_volume(mesh, "grid", false);
+        double volume_tree = support_volume(mesh, "tree", false);
+        REQUIRE(volume_tree > 0.);
+        REQUIRE(volume_tree < volume_grid);
+    }
+    SECTION("branches over a ledge stand on the ledge") {
+        TriangleMesh ledge = make_cube(20., 60., 10.);
+        ledge.translate(10.f, -30.f, 0.f);
+        mesh.merge(ledge);
+        REQUIRE(support_volume(mesh, "tree", false) > 0.);
+    }
+    SECTION("branches avoiding a ledge with support on build plate only") {
+        TriangleMesh ledge = make_cube(20., 60., 10.);
+        ledge.translate(10.f, -30.f, 0.f);
+        mesh.merge(ledge);
+        REQUIRE(support_volume(mesh, "tree", true) > 0.);
+    }
+}
+
 #if 0
 // Test 8.
 TEST_CASE("SupportMaterial: forced support is generated", "[SupportMaterial]")
@@ -52,7 +52,7 @@ SCENARIO("Export+Import geometry to/from 3mf file cycle", "[3mf]") {
         WHEN("model is saved+loaded to/from 3mf file") {
             // save the model to 3mf file
             std::string test_file = std::string(TEST_DATA_DIR) + "/test_3mf/prusa.3mf";
-            store_3mf(test_file.c_str(), &src_model, nullptr, false);
+            store_3mf(test_file.c_str(), &src_model, nullptr, OptionStore3mf().set_fullpath_sources(false));
 
             // load back the model from the 3mf file
             Model dst_model;
@@ -80,6 +80,49 @@ SCENARIO("Export+Import geometry to/from 3mf file cycle", "[3mf]") {
     }
 }
 
+SCENARIO("Export+Import of multiple large volumes to/from 3mf file with various compression levels", "[3mf]") {
+    GIVEN("model with two objects, the first one made of two volumes") {
+        // The meshes are large enough to be serialized in multiple blocks, some of them spanning two volumes.
+        Model src_model;
+        ModelObject *src_object = src_model.add_object();
+        src_object->add_volume(make_sphere(10., 2. * PI / 200.));
+        ModelVolume *cube = src_object->add_volume(make_cube(5., 5., 5.));
+        cube->set_offset({ 12., 0., 0. });
+        src_object->add_instance();
+        ModelObject *src_object2 = src_model.add_object();
+        src_object2->add_volume(make_sphere(8., 2. * PI / 150.));
+        src_object2->add_instance()->set_offset({ 40., 0., 0. });
+
+        for (int compression_level : { 0, 9 }) {
+            WHEN("model is saved+loaded to/from 3mf file with compression level " + std::to_string(compression_level)) {
+                std::string test_file = std::string(TEST_DATA_DIR) + "/test_3mf/spheres.3mf";
+                bool saved = store_3mf(test_file.c_str(), &src_model, nullptr, OptionStore3mf{}.set_compression_level(compression_level));
+
+                Model dst_model;
+                DynamicPrintConfig dst_config;
+                {
+                    ConfigSubstitutionContext ctxt{ ForwardCompatibilitySubstitutionRule::Disable };
+                    load_3mf(test_file.c_str(), dst_config, ctxt, &dst_model, false);
+                }
+                boost::filesystem::remove(test_file);
+
+                THEN("world vertices coordinates and triangles after load match") {
+                    REQUIRE(saved);
+                    REQUIRE(dst_model.objects.size() == src_model.objects.size());
+                    for (size_t i = 0; i < src_model.objects.size(); ++ i) {
+                        TriangleMesh src_mesh = src_model.objects[i]->mesh();
+                        TriangleMesh dst_mesh = dst_model.objects[i]->mesh();
+                        REQUIRE(dst_mesh.its.indices == src_mesh.its.indices);
+                        REQUIRE(dst_mesh.its.vertices.size() == src_mesh.its.vertices.size());
+                        for (size_t j = 0; j < dst_mesh.its.vertices.size(); ++ j)
+                            REQUIRE(dst_mesh.its.vertices[j].isApprox(src_mesh.its.vertices[j]));
+                    }
+                }
+            }
+        }
+    }
+}
+
 SCENARIO("2D convex hull of sinking object", "[3mf]") {
     GIVEN("model") {
         // load a model
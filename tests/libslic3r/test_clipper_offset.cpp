@@ -212,3 +212,95 @@ SCENARIO("Constant offset", "[ClipperUtils]") {
 		}
 	}
 }
+
+TEST_CASE("Clipper engines reused between operations", "[ClipperUtils]") {
+	// A 100x100mm square with a 10x10 grid of rotated square holes.
+	Polygons square { Polygon::new_scale({ { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 } }) };
+	Polygons holes;
+	for (int i = 0; i < 10; ++ i)
+		for (int j = 0; j < 10; ++ j) {
+			Polygon hole = Polygon::new_scale({ { 0, 0 }, { 6, 0 }, { 6, 6 }, { 0, 6 } });
+			hole.rotate(0.1 * (i + j));
+			hole.translate(scaled<coord_t>(10. * i + 2.), scaled<coord_t>(10. * j + 2.));
+			holes.emplace_back(std::move(hole));
+		}
+	const ExPolygons diff_ref   = diff_ex(square, holes);
+	const ExPolygons offset_ref = offset_ex(diff_ref, - scaled<float>(0.5));
+	REQUIRE(diff_ref.size() == 1);
+	REQUIRE(diff_ref.front().holes.size() == 100);
+	REQUIRE(offset_ref.size() == 1);
+
+	// The Clipper engines are pooled, the results must not depend on the state left by the previous operations.
+	SECTION("Repeated operations") {
+		for (size_t i = 0; i < 20; ++ i) {
+			REQUIRE(diff_ex(square, holes) == diff_ref);
+			REQUIRE(offset_ex(diff_ref, - scaled<float>(0.5)) == offset_ref);
+		}
+	}
+	SECTION("Operations following a large one, which makes the pooled engines release their memory") {
+		Polygons large_square { Polygon::new_scale({ { 0, 0 }, { 200, 0 }, { 200, 200 }, { 0, 200 } }) };
+		Polygons large_holes;
+		for (int i = 0; i < 100; ++ i)
+			for (int j = 0; j < 100; ++ j) {
+				Polygon hole = Polygon::new_scale({ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } });
+				hole.translate(scaled<coord_t>(2. * i + 0.5), scaled<coord_t>(2. * j + 0.5));
+				large_holes.emplace_back(std::move(hole));
+			}
+		ExPolygons large = diff_ex(large_square, large_holes);
+		REQUIRE(large.size() == 1);
+		REQUIRE(large.front().holes.size() == 10000);
+		REQUIRE(diff_ex(square, holes) == diff_ref);
+		REQUIRE(offset_ex(large, - scaled<float>(0.2)).size() == 1);
+		REQUIRE(offset_ex(diff_ref, - scaled<float>(0.5)) == offset_ref);
+	}
+}
+
+TEST_CASE("ClipperUtils: clipping polygons culled by the subject bounding box", "[ClipperUtils]") {
+	// A 20x20 grid of 4x4mm squares at 5mm pitch and a grid of 1x1mm subject squares, each overlapping a corner of a grid square.
+	Polygons grid;
+	for (int i = 0; i < 20; ++ i)
+		for (int j = 0; j < 20; ++ j) {
+			Polygon square = Polygon::new_scale({ { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } });
+			square.translate(scaled<coord_t>(5. * i), scaled<coord_t>(5. * j));
+			grid.emplace_back(std::move(square));
+		}
+	ExPolygons subjects;
+	for (int i = 0; i < 20; i += 3)
+		for (int j = 0; j < 20; j += 3) {
+			Polygon square = Polygon::new_scale({ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } });
+			square.translate(scaled<coord_t>(5. * i + 3.5), scaled<coord_t>(5. * j + 3.5));
+			subjects.emplace_back(std::move(square));
+		}
+
+	THEN("Results are the same as with the overlapping clipping polygons only") {
+		for (const ExPolygon &subject : subjects) {
+			Polygons overlapping;
+			for (const Polygon &square : grid)
+				if (get_extents(square).overlap(get_extents(subject)))
+					overlapping.emplace_back(square);
+			REQUIRE(overlapping.size() == 1);
+			REQUIRE(intersection_ex(subject, grid) == intersection_ex(subject, overlapping));
+			REQUIRE(diff_ex(ExPolygons{ subject }, grid) == diff_ex(ExPolygons{ subject }, overlapping));
+			REQUIRE(diff_ex(ExPolygons{ subject }, grid, ApplySafetyOffset::Yes) == diff_ex(ExPolygons{ subject }, overlapping, ApplySafetyOffset::Yes));
+			REQUIRE(std::abs(area(intersection_ex(subject, grid)) - 0.25 * subject.area()) < SCALED_EPSILON * SCALED_EPSILON);
+		}
+	}
+	THEN("Batched operations match the operations on single subjects") {
+		std::vector<ExPolygons> intersections = intersection_ex_batch(subjects, grid);
+		std::vector<ExPolygons> differences   = diff_ex_batch(subjects, grid, ApplySafetyOffset::Yes);
+		REQUIRE(intersections.size() == subjects.size());
+		REQUIRE(differences.size() == subjects.size());
+		for (size_t i = 0; i < subjects.size(); ++ i) {
+			REQUIRE(intersections[i] == intersection_ex(ExPolygons{ subjects[i] }, grid));
+			REQUIRE(differences[i] == diff_ex(ExPolygons{ subjects[i] }, grid, ApplySafetyOffset::Yes));
+		}
+	}
+	THEN("Batched difference normalizes a subject not overlapping any clipping polygon the same way as diff_ex()") {
+		ExPolygon far_away = subjects.front();
+		far_away.translate(scaled<coord_t>(500.), 0);
+		std::vector<ExPolygons> differences = diff_ex_batch(ExPolygons{ far_away }, grid);
+		REQUIRE(differences.front() == diff_ex(ExPolygons{ far_away }, grid));
+		REQUIRE(differences.front().size() == 1);
+		REQUIRE(intersection_ex_batch(ExPolygons{ far_away }, grid).front().empty());
+	}
+}
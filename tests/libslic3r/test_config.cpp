@@ -44,13 +44,13 @@ SCENARIO("Config accessor functions perform as expected.", "[Config]") {
         WHEN("A boolean option is set to a boolean value") {
             REQUIRE_NOTHROW(config.set("gcode_comments", true));
             THEN("The underlying value is set correctly.") {
-                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->getBool() == true);
+                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->get_bool() == true);
             }
         }
         WHEN("A boolean option is set to a string value representing a 0 or 1") {
             CHECK_NOTHROW(config.set_deserialize_strict("gcode_comments", "1"));
             THEN("The underlying value is set correctly.") {
-                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->getBool() == true);
+                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->get_bool() == true);
             }
         }
         WHEN("A boolean option is set to a string value representing something other than 0 or 1") {
@@ -58,7 +58,7 @@ SCENARIO("Config accessor functions perform as expected.", "[Config]") {
                 REQUIRE_THROWS_AS(config.set("gcode_comments", "Z"), BadOptionTypeException);
             }
             AND_THEN("Value is unchanged.") {
-                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->getBool() == false);
+                REQUIRE(config.opt<ConfigOptionBool>("gcode_comments")->get_bool() == false);
             }
         }
         WHEN("A boolean option is set to an int value") {
@@ -84,13 +84,13 @@ SCENARIO("Config accessor functions perform as expected.", "[Config]") {
         WHEN("An floating-point option is set through the integer interface") {
             config.set("perimeter_speed", 10);
             THEN("The underlying value is set correctly.") {
-                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->getFloat() == 10.0);
+                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->get_float() == 10.0);
             }
         }
         WHEN("A floating-point option is set through the double interface") {
             config.set("perimeter_speed", 5.5);
             THEN("The underlying value is set correctly.") {
-                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->getFloat() == 5.5);
+                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->get_float() == 5.5);
             }
         }
         WHEN("An integer-based option is set through the double interface") {
@@ -103,7 +103,7 @@ SCENARIO("Config accessor functions perform as expected.", "[Config]") {
                 REQUIRE_THROWS_AS(config.set_deserialize_strict("perimeter_speed", "zzzz"), BadOptionValueException);
             }
             THEN("The value does not change.") {
-                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->getFloat() == 60.0);
+                REQUIRE(config.opt<ConfigOptionFloat>("perimeter_speed")->get_float() == 60.0);
             }
         }
         WHEN("A string option is set through the string interface") {
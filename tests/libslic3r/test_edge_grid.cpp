@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+#include <test_utils.hpp>
+
+#include <random>
+
+#include <libslic3r/AABBTreeLines.hpp>
+#include <libslic3r/EdgeGrid.hpp>
+#include <libslic3r/Geometry.hpp>
+#include <libslic3r/MTUtils.hpp>
+#include <libslic3r/TriangleMeshSlicer.hpp>
+
+using namespace Slic3r;
+
+// Slices of a test object, centered around the origin.
+static std::vector<ExPolygons> slice_test_object(const std::string &objname, float layer_height)
+{
+    TriangleMesh mesh = load_model(objname);
+    BoundingBoxf3 bb = mesh.bounding_box();
+    mesh.translate(- bb.center().cast<float>());
+    bb = mesh.bounding_box();
+    return slice_mesh_ex(mesh.its, grid(float(bb.min.z()) + layer_height, float(bb.max.z()), layer_height));
+}
+
+// Random query points inside the bounding box of the layer extended by the search radius.
+static Points random_points(const BoundingBox &bbox, coord_t search_radius, size_t num_points)
+{
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<coord_t> dx(bbox.min.x() - search_radius, bbox.max.x() + search_radius);
+    std::uniform_int_distribution<coord_t> dy(bbox.min.y() - search_radius, bbox.max.y() + search_radius);
+    Points out;
+    out.reserve(num_points);
+    for (size_t i = 0; i < num_points; ++ i)
+        out.emplace_back(dx(rng), dy(rng));
+    return out;
+}
+
+TEST_CASE("EdgeGrid: closest point and line crossing match brute force", "[EdgeGrid]")
+{
+    const coord_t search_radius = scaled<coord_t>(2.);
+    for (const ExPolygons &layer : slice_test_object("extruder_idler.obj", 2.f)) {
+        if (layer.empty())
+            continue;
+        EdgeGrid::Grid grid;
+        grid.create(layer, scaled<coord_t>(1.));
+        const Lines lines = to_lines(layer);
+        for (const Point &pt : random_points(get_extents(layer), search_radius, 200)) {
+            double d_min = std::numeric_limits<double>::max();
+            for (const Line &line : lines)
+                d_min = std::min(d_min, line.distance_to(pt));
+            EdgeGrid::Grid::ClosestPointResult cp = grid.closest_point_signed_distance(pt, search_radius);
+            if (d_min < double(search_radius) - SCALED_EPSILON) {
+                REQUIRE(cp.valid());
+                REQUIRE(std::abs(std::abs(cp.distance) - d_min) < SCALED_EPSILON);
+            } else if (d_min > double(search_radius) + SCALED_EPSILON)
+                REQUIRE(! cp.valid());
+        }
+        struct Visitor {
+            bool operator()(coord_t iy, coord_t ix) {
+                auto cell_data_range = grid.cell_data_range(iy, ix);
+                for (auto it_contour_and_segment = cell_data_range.first; it_contour_and_segment != cell_data_range.second; ++ it_contour_and_segment) {
+                    auto segment = grid.segment(*it_contour_and_segment);
+                    if (Geometry::segments_intersect(segment.first, segment.second, line.a, line.b)) {
+                        intersects = true;
+                        return false;
+                    }
+                }
+                return true;
+            }
+            const EdgeGrid::Grid &grid;
+            Line                  line;
+            bool                  intersects { false };
+        };
+        const Points pts = random_points(get_extents(layer), 0, 200);
+        for (size_t i = 0; i + 1 < pts.size(); ++ i) {
+            Visitor visitor { grid, Line(pts[i], pts[i + 1]) };
+            grid.visit_cells_intersecting_line(pts[i], pts[i + 1], visitor);
+            bool intersects = std::any_of(lines.begin(), lines.end(), [&visitor](const Line &l) { return Geometry::segments_intersect(l.a, l.b, visitor.line.a, visitor.line.b); });
+            REQUIRE(visitor.intersects == intersects);
+        }
+    }
+}
+
+TEST_CASE("EdgeGrid: closest point queries compared to AABBTreeLines", "[.][benchmark][EdgeGrid]")
+{
+    const coord_t search_radius = scaled<coord_t>(2.);
+    size_t num_queries = 0;
+    double sum_edge_grid = 0., sum_aabb_tree = 0.;
+    for (const ExPolygons &layer : slice_test_object("extruder_idler.obj", 0.2f)) {
+        if (layer.empty())
+            continue;
+        const Points pts = random_points(get_extents(layer), search_radius, 10000);
+        num_queries += pts.size();
+
+        EdgeGrid::Grid grid;
+        grid.create(layer, scaled<coord_t>(1.));
+        for (const Point &pt : pts)
+            if (EdgeGrid::Grid::ClosestPointResult cp = grid.closest_point_signed_distance(pt, search_radius); cp.valid())
+                sum_edge_grid += std::abs(cp.distance);
+
+        std::vector<Linef> lines;
+        for (const ExPolygon &expoly : layer)
+            for (const Line &line : expoly.lines())
+                lines.emplace_back(unscale(line.a), unscale(line.b));
+        auto tree = AABBTreeLines::build_aabb_tree_over_indexed_lines(lines);
+        for (const Point &pt : pts) {
+            size_t hit_idx;
+            Vec2d  hit_point;
+            double dist = std::sqrt(AABBTreeLines::squared_distance_to_indexed_lines(lines, tree, unscaled(pt), hit_idx, hit_point));
+            if (dist < unscaled(search_radius))
+                sum_aabb_tree += scaled<double>(dist);
+        }
+    }
+    REQUIRE(num_queries > 0);
+    REQUIRE(std::abs(sum_edge_grid - sum_aabb_tree) < 1e-6 * sum_aabb_tree);
+}
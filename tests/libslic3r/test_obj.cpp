@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+#include "test_utils.hpp"
+
+#include "libslic3r/Format/objparser.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
+
+using namespace Slic3r;
+
+// Indexed triangle set built from ObjData, the way OBJ files were loaded before objparse_mesh().
+static indexed_triangle_set its_from_obj_data(const ObjParser::ObjData &data)
+{
+    indexed_triangle_set its;
+    for (size_t i = 0; i < data.coordinates.size(); i += 4)
+        its.vertices.emplace_back(data.coordinates[i], data.coordinates[i + 1], data.coordinates[i + 2]);
+    std::vector<int> face;
+    for (const ObjParser::ObjVertex &vertex : data.vertices)
+        if (vertex.coordIdx != -1)
+            face.emplace_back(vertex.coordIdx);
+        else if (! face.empty()) {
+            its.indices.emplace_back(face[0], face[1], face[2]);
+            if (face.size() == 4)
+                its.indices.emplace_back(face[0], face[2], face[3]);
+            face.clear();
+        }
+    return its;
+}
+
+SCENARIO("Parsing the mesh of an OBJ file", "[OBJ]") {
+    GIVEN("OBJ files with triangles and quads") {
+        for (const char *name : { "20mm_cube.obj", "extruder_idler_quads.obj", "frog_legs.obj" }) {
+            const std::string path = get_model_path(name);
+            WHEN(std::string("the mesh of ") + name + " is parsed") {
+                indexed_triangle_set its;
+                std::string          error;
+                bool                 ok = ObjParser::objparse_mesh(path.c_str(), its, error);
+                THEN("it matches the mesh parsed through ObjData") {
+                    ObjParser::ObjData data;
+                    REQUIRE(ObjParser::objparse(path.c_str(), data));
+                    indexed_triangle_set expected = its_from_obj_data(data);
+                    REQUIRE(ok);
+                    REQUIRE(its.vertices == expected.vertices);
+                    REQUIRE(its.indices == expected.indices);
+                }
+            }
+        }
+    }
+    GIVEN("OBJ file with relative vertex indices, texture and normal indices and CR LF line endings") {
+        const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.obj");
+        {
+            boost::nowide::ofstream file(path.string(), std::ios::binary);
+            file << "# comment\r\nv 0 0 0\r\nv +1 0 0 1\r\nvt 0 0\r\nvn 0 0 1\r\nv 1 1 0\r\nv 0 1.5e0 0\r\n"
+                    "f 1/1/1 2/1/1 3/1/1\r\nf -4//1 -2//1 -1//1\r\n\tf 1 2 3 4\r\n";
+        }
+        WHEN("the mesh is parsed") {
+            indexed_triangle_set its;
+            std::string          error;
+            bool                 ok = ObjParser::objparse_mesh(path.string().c_str(), its, error);
+            THEN("all faces are resolved to absolute vertex indices") {
+                REQUIRE(ok);
+                REQUIRE(its.vertices.size() == 4);
+                REQUIRE(its.vertices[3] == stl_vertex(0.f, 1.5f, 0.f));
+                REQUIRE(its.indices.size() == 4);
+                REQUIRE(its.indices[0] == stl_triangle_vertex_indices(0, 1, 2));
+                REQUIRE(its.indices[1] == stl_triangle_vertex_indices(0, 2, 3));
+                REQUIRE(its.indices[2] == stl_triangle_vertex_indices(0, 1, 2));
+                REQUIRE(its.indices[3] == stl_triangle_vertex_indices(0, 2, 3));
+            }
+        }
+        boost::filesystem::remove(path);
+    }
+    GIVEN("OBJ file referencing a vertex, which does not exist") {
+        const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.obj");
+        {
+            boost::nowide::ofstream file(path.string(), std::ios::binary);
+            file << "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n";
+        }
+        WHEN("the mesh is parsed") {
+            indexed_triangle_set its;
+            std::string          error;
+            bool                 ok = ObjParser::objparse_mesh(path.string().c_str(), its, error);
+            THEN("parsing fails") {
+                REQUIRE(! ok);
+                REQUIRE(! error.empty());
+            }
+        }
+        boost::filesystem::remove(path);
+    }
+}
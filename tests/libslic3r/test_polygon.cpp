@@ -43,13 +43,13 @@ SCENARIO("Converted Perl tests", "[Polygon]") {
                 { { 100, 200 }, { 100, 100 } } });
         }
         THEN("split_at_first_point") {
-            REQUIRE(ccw_square.split_at_first_point() == Polyline { ccw_square[0], ccw_square[1], ccw_square[2], ccw_square[3], ccw_square[0] });
+            REQUIRE(ccw_square.split_at_first_point().points == Points { ccw_square[0], ccw_square[1], ccw_square[2], ccw_square[3], ccw_square[0] });
         }
         THEN("split_at_index(2)") {
-            REQUIRE(ccw_square.split_at_index(2) == Polyline { ccw_square[2], ccw_square[3], ccw_square[0], ccw_square[1], ccw_square[2] });
+            REQUIRE(ccw_square.split_at_index(2).points == Points { ccw_square[2], ccw_square[3], ccw_square[0], ccw_square[1], ccw_square[2] });
         }
         THEN("split_at_vertex(ccw_square[2])") {
-            REQUIRE(ccw_square.split_at_vertex(ccw_square[2]) == Polyline { ccw_square[2], ccw_square[3], ccw_square[0], ccw_square[1], ccw_square[2] });
+            REQUIRE(ccw_square.split_at_vertex(ccw_square[2]).points == Points { ccw_square[2], ccw_square[3], ccw_square[0], ccw_square[1], ccw_square[2] });
         }
         THEN("is_counter_clockwise") {
             REQUIRE(ccw_square.is_counter_clockwise());
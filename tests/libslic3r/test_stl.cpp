@@ -2,6 +2,9 @@
 
 #include "libslic3r/Model.hpp"
 #include "libslic3r/Format/STL.hpp"
+#include "libslic3r/Format/MeshCache.hpp"
+
+#include <boost/filesystem/operations.hpp>
 
 using namespace Slic3r;
 
@@ -55,3 +58,32 @@ SCENARIO("Reading an STL file", "[stl]") {
 		}
 	}
 }
+
+SCENARIO("Loading an STL file through the mesh cache", "[stl]") {
+	GIVEN("mesh cache enabled in a temporary directory") {
+		const boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+		set_mesh_cache_dir(cache_dir.string());
+		const std::string path = stl_path("ASCII/20mmbox-LF.stl");
+		WHEN("the same file is loaded twice") {
+			Model first  = Model::read_from_file(path);
+			Model second = Model::read_from_file(path);
+			THEN("the second load reads the cache and the models match") {
+				REQUIRE(boost::filesystem::exists(cache_dir));
+				REQUIRE(! boost::filesystem::is_empty(cache_dir));
+				REQUIRE(first.objects.size() == second.objects.size());
+				const ModelVolume &v1 = *first.objects.front()->volumes.front();
+				const ModelVolume &v2 = *second.objects.front()->volumes.front();
+				REQUIRE(first.objects.front()->name == second.objects.front()->name);
+				REQUIRE(v1.name == v2.name);
+				REQUIRE(v1.mesh().its.vertices == v2.mesh().its.vertices);
+				REQUIRE(v1.mesh().its.indices == v2.mesh().its.indices);
+				REQUIRE(v1.mesh().stats().number_of_parts == v2.mesh().stats().number_of_parts);
+				REQUIRE(v1.mesh().stats().volume == v2.mesh().stats().volume);
+				REQUIRE(is_approx(v1.get_offset(), v2.get_offset()));
+				REQUIRE(is_approx(v1.source.mesh_offset, v2.source.mesh_offset));
+			}
+		}
+		set_mesh_cache_dir(std::string());
+		boost::filesystem::remove_all(cache_dir);
+	}
+}
@@ -9,6 +9,9 @@
 
 #include <libslic3r/Geometry/VoronoiOffset.hpp>
 #include <libslic3r/Geometry/VoronoiVisualUtils.hpp>
+#include <libslic3r/TriangleMeshSlicer.hpp>
+
+#include "test_data.hpp"
 
 #include <numeric>
 
@@ -23,7 +26,7 @@ using boost::polygon::voronoi_diagram;
 
 using namespace Slic3r;
 
-using VD = Slic3r::VoronoiDiagram;
+using VD = Slic3r::Geometry::VoronoiDiagram;
 
 // https://svn.boost.org/trac10/ticket/12067
 // This bug seems to be confirmed.
@@ -2190,3 +2193,40 @@ TEST_CASE("Non-planar voronoi diagram", "[VoronoiNonPlanar]")
 
 //    REQUIRE(Geometry::VoronoiUtilsCgal::is_voronoi_diagram_planar_intersection(vd));
 }
+
+// MedialAxis::polyline_from_voronoi() simplifies an outline of n segments before building its Voronoi diagram
+// if 5n edges are already over its limit. Its thin walls are the same as when it built the diagram first
+// only if no diagram has less than 5n edges.
+TEST_CASE("Voronoi diagram of n segments has at least 5n edges", "[Voronoi]")
+{
+    auto check_edges = [](const ExPolygon &expoly) {
+        VD    vd;
+        Lines lines = expoly.lines();
+        construct_voronoi(lines.begin(), lines.end(), &vd);
+        CHECK(vd.edges().size() >= 5 * lines.size());
+        CHECK(vd.edges().size() <= 12 * lines.size());
+    };
+
+    SECTION("Slices of thin wall models") {
+        for (Test::TestMesh m : { Test::TestMesh::gt2_teeth, Test::TestMesh::two_hollow_squares, Test::TestMesh::small_dorito,
+                                  Test::TestMesh::ipadstand, Test::TestMesh::A, Test::TestMesh::V }) {
+            TriangleMesh       mesh = Test::mesh(m);
+            BoundingBoxf3      bbox = mesh.bounding_box();
+            std::vector<float> zs;
+            for (double z = bbox.min.z() + 0.1; z < bbox.max.z(); z += 0.5)
+                zs.emplace_back(float(z));
+            for (const ExPolygons &slices : slice_mesh_ex(mesh.its, zs))
+                for (const ExPolygon &expoly : slices)
+                    check_edges(expoly);
+        }
+    }
+
+    SECTION("Strip with collinear segments") {
+        ExPolygon expoly;
+        for (int i = 0; i < 3000; ++ i)
+            expoly.contour.points.emplace_back(i * 1000, 0);
+        for (int i = 3000; i > 0; -- i)
+            expoly.contour.points.emplace_back(i * 1000, 400);
+        check_edges(expoly);
+    }
+}
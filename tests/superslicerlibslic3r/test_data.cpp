@@ -267,7 +267,7 @@ TriangleMesh mesh(TestMesh m) {
 
 
 void init_print(Print& print, std::initializer_list<TestMesh> meshes, Slic3r::Model& model, DynamicPrintConfig* _config, bool comments) {
-	DynamicPrintConfig &config = Slic3r::DynamicPrintConfig::full_print_config();
+	DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
     config.apply(*_config);
     
     //remove print of status
@@ -304,7 +304,7 @@ void init_print(Print& print, std::initializer_list<TestMesh> meshes, Slic3r::Mo
 }
 
 void init_print(Print& print, std::vector<TriangleMesh> meshes, Slic3r::Model& model, DynamicPrintConfig* _config, bool comments) {
-	DynamicPrintConfig &config = Slic3r::DynamicPrintConfig::full_print_config();
+	DynamicPrintConfig config = Slic3r::DynamicPrintConfig::full_print_config();
     config.apply(*_config);
     
     //remove print of status
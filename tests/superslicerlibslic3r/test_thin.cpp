@@ -470,6 +470,27 @@ SCENARIO("thin walls: ")
         }
     }
 
+    GIVEN("narrow strip with a detailed outline")
+    {
+        // 12000 segments: too many for a single Voronoi diagram, the outline is simplified before it is built.
+        ExPolygon expolygon;
+        for (int i = 0; i < 6000; ++i)
+            expolygon.contour.points.push_back(Point::new_scale(0.05 * i, 0.2 + 0.05 * std::sin(i * 0.01)));
+        for (int i = 5999; i >= 0; --i)
+            expolygon.contour.points.push_back(Point::new_scale(0.05 * i, 0.8 + 0.05 * std::cos(i * 0.013)));
+        expolygon.contour.make_counter_clockwise();
+        WHEN("creating the medial axis") {
+            ThickPolylines res;
+            MedialAxis{ expolygon, scale_t(1.), scale_t(0.2), scale_t(0.2) }.build(res);
+            THEN("medial axis is a single polyline") {
+                REQUIRE(res.size() == 1);
+                THEN("medial axis spans the whole strip") {
+                    REQUIRE(std::abs(res[0].length() - scale_(299.95)) < scale_(0.1));
+                }
+            }
+        }
+    }
+
     GIVEN("GH #2474")
     {
         ExPolygon expolygon;